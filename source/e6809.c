@@ -1,4 +1,8 @@
 #include <stdio.h>
+#include <string.h>
+#ifdef E6809_PROFILE
+#include <stdlib.h>
+#endif
 #include "e6809.h"
 
 /* code assumptions:
@@ -26,67 +30,144 @@ enum {
 	IRQ_CWAI	= 2
 };
 
-/* index registers */
+/* the registers and the rest of the state live in e6809_t (e6809.h), every
+ * function here gets the cpu it works on as its first argument.
+ *
+ * lazy condition codes. the alu instructions only record what they did
+ * (kind of operation, inputs and result) and cc_lazy marks the flags in
+ * reg_cc that still have to be computed from that record. they are worked
+ * out when an instruction looks at them or the whole register is needed.
+ * define E6809_EAGER_CC to compute them right away instead.
+ */
 
-static unsigned short reg_x;
-static unsigned short reg_y;
+enum {
+	CC_ADD8,  /* i0 + i1 (+ carry) */
+	CC_SUB8,  /* i0 + ~data (+ 1 - borrow), carry inverted */
+	CC_ADD16,
+	CC_SUB16,
+	CC_TST8,  /* n and z from r, v cleared */
+	CC_TST16
+};
 
-/* user stack pointer */
+/* memory map. every 256 byte page of the address space either points
+ * straight at host memory or is handled by user defined functions. the
+ * pointers are already offset so that mem[address & 0xff] is the byte.
+ * unmapped memory reads as 0xff (open_bus) and swallows writes (discard).
+ *
+ * decoded instruction cache.
+ * instructions are fetched and decoded once and then kept in dcache,
+ * keyed by their address, as long as they come from a region that was
+ * registered with e6809_dcache_map. the handlers read their operands from
+ * the cached copy instead of going through the memory map again.
+ * dcache_page holds the DCACHE_* attributes of every page and dcache_alias
+ * the page where the cached copy of a mirrored page lives. writes only need
+ * to look at the cache while dcache_watched is not zero.
+ */
 
-static unsigned short reg_u;
+enum {
+	DCACHE_SIZE		= E6809_DCACHE_SIZE,
+	DCACHE_EXEC		= 1,    /* page attribute: code may be cached */
+	DCACHE_WATCH	= 2     /* page attribute: writes invalidate code */
+};
 
-/* hardware stack pointer */
+typedef e6809_dcache_t dcache_t;
 
-static unsigned short reg_s;
+#ifdef E6809_RECOMPILED
+static void rec_check (e6809_t *cpu);
+#endif
 
-/* program counter */
+static void dcache_flush (e6809_t *cpu)
+{
+	unsigned i;
 
-static unsigned short reg_pc;
+	for (i = 0; i < DCACHE_SIZE; i++) {
+		cpu->dcache[i].len = 0;
+	}
 
-/* accumulators */
+	for (i = 0; i < E6809_BLOCKS; i++) {
+		cpu->blocks[i].used = 0;
+	}
 
-static unsigned short reg_a;
-static unsigned short reg_b;
+	cpu->dcache_watched = 0;
 
-/* direct page register */
+#ifdef E6809_RECOMPILED
+	rec_check (cpu);
+#endif
+}
 
-static unsigned short reg_dp;
+/* drop every cached instruction that covers the given address */
 
-/* condition codes */
+static void dcache_invalidate (e6809_t *cpu, unsigned short address)
+{
+	dcache_t *e;
+	unsigned short pc, i;
 
-static unsigned short reg_cc;
+	pc = (cpu->dcache_alias[address >> 8] << 8) | (address & 0xff);
 
-/* flag to see if interrupts should be handled (sync/cwai). */
+	for (i = 0; i < E6809_DCACHE_MAXLEN; i++, pc--) {
+		e = &cpu->dcache[pc & (DCACHE_SIZE - 1)];
 
-static unsigned short irq_status;
+		if (e->pc == pc && e->len > i) {
+			e->len = 0;
+			cpu->dcache_watched--;
+		}
+	}
+}
 
-static unsigned short *rptr_xyus[4] = {
-	&reg_x,
-	&reg_y,
-	&reg_u,
-	&reg_s
-};
+void e6809_map_read (e6809_t *cpu, unsigned start, unsigned end, unsigned char *mem, e6809_read_t io)
+{
+	unsigned page, i;
 
-/* user defined read and write functions */
+	for (page = start >> 8; page <= (end >> 8); page++) {
+		if (mem) {
+			cpu->map_rd[page] = mem + (page << 8) - (start & 0xff00);
+		} else if (io) {
+			cpu->map_rd[page] = 0;
+		} else {
+			for (i = 0; i < 256; i++) {
+				cpu->open_bus[i] = 0xff;
+			}
 
-unsigned char (*e6809_read8) (unsigned short address);
-void (*e6809_write8) (unsigned short address, unsigned char data);
+			cpu->map_rd[page] = cpu->open_bus;
+		}
 
-/* obtain a particular condition code. returns 0 or 1. */
+		cpu->io_rd[page] = io;
+	}
 
-static einline unsigned short get_cc (unsigned short flag)
-{
-	return (reg_cc / flag) & 1;
+	/* translated blocks know which accesses go to i/o */
+
+	dcache_flush (cpu);
 }
 
-/* set a particular condition code to either 0 or 1.
- * value parameter must be either 0 or 1.
- */
+void e6809_map_write (e6809_t *cpu, unsigned start, unsigned end, unsigned char *mem, e6809_write_t io)
+{
+	unsigned page;
+
+	for (page = start >> 8; page <= (end >> 8); page++) {
+		if (mem) {
+			cpu->map_wr[page] = mem + (page << 8) - (start & 0xff00);
+		} else if (io) {
+			cpu->map_wr[page] = 0;
+		} else {
+			cpu->map_wr[page] = cpu->discard;
+		}
+
+		cpu->io_wr[page] = io;
+	}
 
-static einline void set_cc (unsigned short flag, unsigned short value)
+	dcache_flush (cpu);
+}
+
+void e6809_dcache_map (e6809_t *cpu, unsigned start, unsigned end, unsigned attr, unsigned alias)
 {
-	reg_cc &= ~flag;
-	reg_cc |= value * flag;
+	unsigned page;
+
+	for (page = start >> 8; page <= (end >> 8); page++) {
+		cpu->dcache_page[page] = attr;
+		cpu->dcache_alias[page] = (alias >> 8) + page - (start >> 8);
+	}
+
+	dcache_flush (cpu);
 }
 
 /* test carry */
@@ -160,103 +241,260 @@ static einline unsigned short  test_v (unsigned short  i0, unsigned short  i1, u
 	return flag;
 }
 
-static einline unsigned short  get_reg_d (void)
+/* the flags of an alu operation recorded by cc_defer */
+
+static einline unsigned short  cc_compute (unsigned short  kind, unsigned short  i0,
+	unsigned short  i1, unsigned short  r)
+{
+	unsigned short  cc;
+
+	switch (kind) {
+	case CC_ADD8:
+	case CC_SUB8:
+		cc  = test_c (i0 << 4, i1 << 4, r << 4, 0) * FLAG_H;
+		cc |= test_n (r) * FLAG_N;
+		cc |= test_z8 (r) * FLAG_Z;
+		cc |= test_v (i0, i1, r) * FLAG_V;
+		cc |= test_c (i0, i1, r, kind == CC_SUB8) * FLAG_C;
+		break;
+	case CC_ADD16:
+	case CC_SUB16:
+		cc  = test_n (r >> 8) * FLAG_N;
+		cc |= test_z16 (r) * FLAG_Z;
+		cc |= test_v (i0 >> 8, i1 >> 8, r >> 8) * FLAG_V;
+		cc |= test_c (i0 >> 8, i1 >> 8, r >> 8, kind == CC_SUB16) * FLAG_C;
+		break;
+	case CC_TST8:
+		cc  = test_n (r) * FLAG_N;
+		cc |= test_z8 (r) * FLAG_Z;
+		break;
+	default:
+		cc  = test_n (r >> 8) * FLAG_N;
+		cc |= test_z16 (r) * FLAG_Z;
+		break;
+	}
+
+	return cc;
+}
+
+/* compute the pending flags from the recorded operation */
+
+static void cc_eval (e6809_t *cpu)
+{
+	unsigned short  cc;
+
+	cc = cc_compute (cpu->cc_kind, cpu->cc_i0, cpu->cc_i1, cpu->cc_r);
+	cpu->reg_cc = (cpu->reg_cc & ~cpu->cc_lazy) | (cc & cpu->cc_lazy);
+	cpu->cc_lazy = 0;
+}
+
+/* record an alu operation, flags are the condition codes it sets. any
+ * flag of the previous operation that this one leaves alone is computed
+ * first.
+ */
+
+static einline void cc_defer (e6809_t *cpu, unsigned short kind, unsigned short flags,
+	unsigned short i0, unsigned short i1, unsigned short r)
+{
+	if (cpu->cc_lazy & ~flags) {
+		cc_eval (cpu);
+	}
+
+	cpu->cc_kind = kind;
+	cpu->cc_i0 = i0;
+	cpu->cc_i1 = i1;
+	cpu->cc_r = r;
+	cpu->cc_lazy = flags;
+
+#ifdef E6809_EAGER_CC
+	cc_eval (cpu);
+#endif
+}
+
+/* obtain a particular condition code. returns 0 or 1. */
+
+static einline unsigned short get_cc (e6809_t *cpu, unsigned short flag)
+{
+	if (cpu->cc_lazy & flag) {
+		cc_eval (cpu);
+	}
+
+	return (cpu->reg_cc / flag) & 1;
+}
+
+/* set a particular condition code to either 0 or 1.
+ * value parameter must be either 0 or 1.
+ */
+
+static einline void set_cc (e6809_t *cpu, unsigned short flag, unsigned short value)
+{
+	cpu->cc_lazy &= ~flag;
+	cpu->reg_cc &= ~flag;
+	cpu->reg_cc |= value * flag;
+}
+
+/* the whole condition code register */
+
+static einline unsigned short get_reg_cc (e6809_t *cpu)
+{
+	if (cpu->cc_lazy) {
+		cc_eval (cpu);
+	}
+
+	return cpu->reg_cc;
+}
+
+static einline void set_reg_cc (e6809_t *cpu, unsigned short value)
+{
+	cpu->reg_cc = value;
+	cpu->cc_lazy = 0;
+}
+
+static einline unsigned short  get_reg_d (e6809_t *cpu)
 {
-	return (reg_a << 8) | (reg_b & 0xff);
+	return (cpu->reg_a << 8) | (cpu->reg_b & 0xff);
 }
 
-static einline void set_reg_d (unsigned short  value)
+static einline void set_reg_d (e6809_t *cpu, unsigned short  value)
 {
-	reg_a = value >> 8;
-	reg_b = value;
+	cpu->reg_a = value >> 8;
+	cpu->reg_b = value;
 }
 
 /* read a byte ... the returned value has the lower 8-bits set to the byte
  * while the upper bits are all zero.
  */
 
-static einline unsigned short  read8 (unsigned short  address)
+static einline unsigned short  read8 (e6809_t *cpu, unsigned short  address)
 {
-	return (*e6809_read8) (address & 0xffff);
+	const unsigned char *mem;
+
+	mem = cpu->map_rd[address >> 8];
+
+	if (mem) {
+		return mem[address & 0xff];
+	}
+
+	return (*cpu->io_rd[address >> 8]) (cpu, address);
 }
 
 /* write a byte ... only the lower 8-bits of the unsigned data
  * is written. the upper bits are ignored.
  */
 
-static einline void write8 (unsigned short  address, unsigned short  data)
+static einline void write8 (e6809_t *cpu, unsigned short  address, unsigned short  data)
 {
-	(*e6809_write8) (address & 0xffff, (unsigned char) data);
+	unsigned char *mem;
+
+	if (cpu->dcache_watched && (cpu->dcache_page[address >> 8] & DCACHE_WATCH)) {
+		dcache_invalidate (cpu, address);
+	}
+
+	cpu->run_wrote = 1;
+	mem = cpu->map_wr[address >> 8];
+
+	if (mem) {
+		mem[address & 0xff] = (unsigned char) data;
+	} else {
+		(*cpu->io_wr[address >> 8]) (cpu, address, (unsigned char) data);
+	}
 }
 
-static einline unsigned short  read16 (unsigned short  address)
+/* the 16-bit accesses go straight to host memory if both bytes are in the
+ * same directly mapped page.
+ */
+
+static einline unsigned short  read16 (e6809_t *cpu, unsigned short  address)
 {
+	const unsigned char *mem;
 	unsigned short  datahi, datalo;
 
-	datahi = read8 (address);
-	datalo = read8 (address + 1);
+	mem = cpu->map_rd[address >> 8];
+
+	if (mem && (address & 0xff) != 0xff) {
+		mem += address & 0xff;
+
+		return (mem[0] << 8) | mem[1];
+	}
+
+	datahi = read8 (cpu, address);
+	datalo = read8 (cpu, address + 1);
 
 	return (datahi << 8) | datalo;
 }
 
-static einline void write16 (unsigned short  address, unsigned short  data)
+static einline void write16 (e6809_t *cpu, unsigned short  address, unsigned short  data)
 {
-	write8 (address, data >> 8);
-	write8 (address + 1, data);
+	write8 (cpu, address, data >> 8);
+	write8 (cpu, address + 1, data);
 }
 
-static einline void push8 (unsigned short  *sp, unsigned short  data)
+static einline void push8 (e6809_t *cpu, unsigned short  *sp, unsigned short  data)
 {
 	(*sp)--;
-	write8 (*sp, data);
+	write8 (cpu, *sp, data);
 }
 
-static einline unsigned short  pull8 (unsigned short  *sp)
+static einline unsigned short  pull8 (e6809_t *cpu, unsigned short  *sp)
 {
 	unsigned short  data;
 
-	data = read8 (*sp);
+	data = read8 (cpu, *sp);
 	(*sp)++;
 
 	return data;
 }
 
-static einline void push16 (unsigned short  *sp, unsigned short  data)
+static einline void push16 (e6809_t *cpu, unsigned short  *sp, unsigned short  data)
 {
-	push8 (sp, data);
-	push8 (sp, data >> 8);
+	unsigned short  address;
+	unsigned char *mem;
+
+	address = *sp - 2;
+	mem = cpu->map_wr[address >> 8];
+
+	if (mem && (address & 0xff) != 0xff && cpu->dcache_watched == 0) {
+		mem += address & 0xff;
+		mem[1] = (unsigned char) data;
+		mem[0] = (unsigned char) (data >> 8);
+		*sp = address;
+		cpu->run_wrote = 1;
+	} else {
+		push8 (cpu, sp, data);
+		push8 (cpu, sp, data >> 8);
+	}
 }
 
-static einline unsigned short  pull16 (unsigned short  *sp)
+static einline unsigned short  pull16 (e6809_t *cpu, unsigned short  *sp)
 {
-	unsigned short  datahi, datalo;
+	unsigned short  data;
 
-	datahi = pull8 (sp);
-	datalo = pull8 (sp);
+	data = read16 (cpu, *sp);
+	*sp += 2;
 
-	return (datahi << 8) | datalo;
+	return data;
 }
 
-/* read a byte from the address pointed to by the pc */
+/* read a byte from the address pointed to by the pc. the instruction has
+ * already been fetched by the decoder so this comes from the cached copy.
+ */
 
-static einline unsigned short  pc_read8 (void)
+static einline unsigned short  pc_read8 (e6809_t *cpu)
 {
-	unsigned short  data;
+	cpu->reg_pc++;
 
-	data = read8 (reg_pc);
-	reg_pc++;
-
-	return data;
+	return *cpu->fetch++;
 }
 
 /* read a word from the address pointed to by the pc */
 
-static einline unsigned short  pc_read16 (void)
+static einline unsigned short  pc_read16 (e6809_t *cpu)
 {
 	unsigned short  data;
 
-	data = read16 (reg_pc);
-	reg_pc += 2;
+	data = (cpu->fetch[0] << 8) | cpu->fetch[1];
+	cpu->fetch += 2;
+	cpu->reg_pc += 2;
 
 	return data;
 }
@@ -273,243 +511,98 @@ static einline unsigned short  sign_extend (unsigned short  data)
  * instruction itself.
  */
 
-static einline unsigned short  ea_direct (void)
+static einline unsigned short  ea_direct (e6809_t *cpu)
 {
-	return (reg_dp << 8) | pc_read8 ();
+	return (cpu->reg_dp << 8) | pc_read8 (cpu);
 }
 
 /* extended addressing, address is obtained from 2 bytes following
  * the instruction.
  */
 
-static einline unsigned short  ea_extended (void)
+static einline unsigned short  ea_extended (e6809_t *cpu)
 {
-	return pc_read16 ();
+	return pc_read16 (cpu);
 }
 
-/* indexed addressing */
+/* base register of an indexed mode post byte */
 
-static einline unsigned short  ea_indexed (unsigned short  *cycles)
+static einline unsigned short  *idx_reg (e6809_t *cpu, unsigned short  reg)
 {
-	unsigned short  r, op, ea;
-
-	/* post byte */
-
-	op = pc_read8 ();
-
-	r = (op >> 5) & 3;
-
-	switch (op) {
-	case 0x00: case 0x01: case 0x02: case 0x03:
-	case 0x04: case 0x05: case 0x06: case 0x07:
-	case 0x08: case 0x09: case 0x0a: case 0x0b:
-	case 0x0c: case 0x0d: case 0x0e: case 0x0f:
-	case 0x20: case 0x21: case 0x22: case 0x23:
-	case 0x24: case 0x25: case 0x26: case 0x27:
-	case 0x28: case 0x29: case 0x2a: case 0x2b:
-	case 0x2c: case 0x2d: case 0x2e: case 0x2f:
-	case 0x40: case 0x41: case 0x42: case 0x43:
-	case 0x44: case 0x45: case 0x46: case 0x47:
-	case 0x48: case 0x49: case 0x4a: case 0x4b:
-	case 0x4c: case 0x4d: case 0x4e: case 0x4f:
-	case 0x60: case 0x61: case 0x62: case 0x63:
-	case 0x64: case 0x65: case 0x66: case 0x67:
-	case 0x68: case 0x69: case 0x6a: case 0x6b:
-	case 0x6c: case 0x6d: case 0x6e: case 0x6f:
-		/* R, +[0, 15] */
-
-		ea = *rptr_xyus[r] + (op & 0xf);
-		(*cycles)++;
-		break;
-	case 0x10: case 0x11: case 0x12: case 0x13:
-	case 0x14: case 0x15: case 0x16: case 0x17:
-	case 0x18: case 0x19: case 0x1a: case 0x1b:
-	case 0x1c: case 0x1d: case 0x1e: case 0x1f:
-	case 0x30: case 0x31: case 0x32: case 0x33:
-	case 0x34: case 0x35: case 0x36: case 0x37:
-	case 0x38: case 0x39: case 0x3a: case 0x3b:
-	case 0x3c: case 0x3d: case 0x3e: case 0x3f:
-	case 0x50: case 0x51: case 0x52: case 0x53:
-	case 0x54: case 0x55: case 0x56: case 0x57:
-	case 0x58: case 0x59: case 0x5a: case 0x5b:
-	case 0x5c: case 0x5d: case 0x5e: case 0x5f:
-	case 0x70: case 0x71: case 0x72: case 0x73:
-	case 0x74: case 0x75: case 0x76: case 0x77:
-	case 0x78: case 0x79: case 0x7a: case 0x7b:
-	case 0x7c: case 0x7d: case 0x7e: case 0x7f:
-		/* R, +[-16, -1] */
-
-		ea = *rptr_xyus[r] + (op & 0xf) - 0x10;
-		(*cycles)++;
-		break;
-	case 0x80: case 0x81:
-	case 0xa0: case 0xa1:
-	case 0xc0: case 0xc1:
-	case 0xe0: case 0xe1:
-		/* ,R+ / ,R++ */
-
-		ea = *rptr_xyus[r];
-		*rptr_xyus[r] += 1 + (op & 1);
-		*cycles += 2 + (op & 1);
-		break;
-	case 0x90: case 0x91:
-	case 0xb0: case 0xb1:
-	case 0xd0: case 0xd1:
-	case 0xf0: case 0xf1:
-		/* [,R+] ??? / [,R++] */
-
-		ea = read16 (*rptr_xyus[r]);
-		*rptr_xyus[r] += 1 + (op & 1);
-		*cycles += 5 + (op & 1);
-		break;
-	case 0x82: case 0x83:
-	case 0xa2: case 0xa3:
-	case 0xc2: case 0xc3:
-	case 0xe2: case 0xe3:
-
-		/* ,-R / ,--R */
-
-		*rptr_xyus[r] -= 1 + (op & 1);
-		ea = *rptr_xyus[r];
-		*cycles += 2 + (op & 1);
-		break;
-	case 0x92: case 0x93:
-	case 0xb2: case 0xb3:
-	case 0xd2: case 0xd3:
-	case 0xf2: case 0xf3:
-		/* [,-R] ??? / [,--R] */
-
-		*rptr_xyus[r] -= 1 + (op & 1);
-		ea = read16 (*rptr_xyus[r]);
-		*cycles += 5 + (op & 1);
-		break;
-	case 0x84: case 0xa4:
-	case 0xc4: case 0xe4:
-		/* ,R */
-
-		ea = *rptr_xyus[r];
-		break;
-	case 0x94: case 0xb4:
-	case 0xd4: case 0xf4:
-		/* [,R] */
+	switch (reg) {
+	case E6809_REG_X:
+		return &cpu->reg_x;
+	case E6809_REG_Y:
+		return &cpu->reg_y;
+	case E6809_REG_U:
+		return &cpu->reg_u;
+	case E6809_REG_S:
+		return &cpu->reg_s;
+	}
 
-		ea = read16 (*rptr_xyus[r]);
-		*cycles += 3;
-		break;
-	case 0x85: case 0xa5:
-	case 0xc5: case 0xe5:
-		/* B,R */
+	return &cpu->reg_pc;
+}
 
-		ea = *rptr_xyus[r] + sign_extend (reg_b);
-		*cycles += 1;
-		break;
-	case 0x95: case 0xb5:
-	case 0xd5: case 0xf5:
-		/* [B,R] */
+/* indexed addressing */
 
-		ea = read16 (*rptr_xyus[r] + sign_extend (reg_b));
-		*cycles += 4;
-		break;
-	case 0x86: case 0xa6:
-	case 0xc6: case 0xe6:
-		/* A,R */
+static einline unsigned short  ea_indexed (e6809_t *cpu, unsigned short  *cycles)
+{
+	const e6809_postbyte_t *pb;
+	unsigned short  *r, ea;
 
-		ea = *rptr_xyus[r] + sign_extend (reg_a);
-		*cycles += 1;
-		break;
-	case 0x96: case 0xb6:
-	case 0xd6: case 0xf6:
-		/* [A,R] */
+	/* post byte */
 
-		ea = read16 (*rptr_xyus[r] + sign_extend (reg_a));
-		*cycles += 4;
-		break;
-	case 0x88: case 0xa8:
-	case 0xc8: case 0xe8:
-		/* byte,R */
+	pb = &e6809_postbytes[pc_read8 (cpu)];
+	r = idx_reg (cpu, pb->reg);
 
-		ea = *rptr_xyus[r] + sign_extend (pc_read8 ());
-		*cycles += 1;
-		break;
-	case 0x98: case 0xb8:
-	case 0xd8: case 0xf8:
-		/* [byte,R] */
+	/* the offset has to be read before the pc is used as the base */
 
-		ea = read16 (*rptr_xyus[r] + sign_extend (pc_read8 ()));
-		*cycles += 4;
+	switch (pb->kind) {
+	case E6809_IDX_OFF5:
+		ea = *r + pb->offset;
 		break;
-	case 0x89: case 0xa9:
-	case 0xc9: case 0xe9:
-		/* word,R */
-
-		ea = *rptr_xyus[r] + pc_read16 ();
-		*cycles += 4;
+	case E6809_IDX_ZERO:
+		ea = *r;
 		break;
-	case 0x99: case 0xb9:
-	case 0xd9: case 0xf9:
-		/* [word,R] */
-
-		ea = read16 (*rptr_xyus[r] + pc_read16 ());
-		*cycles += 7;
+	case E6809_IDX_INC:
+		ea = *r;
+		*r += pb->offset;
 		break;
-	case 0x8b: case 0xab:
-	case 0xcb: case 0xeb:
-		/* D,R */
-
-		ea = *rptr_xyus[r] + get_reg_d ();
-		*cycles += 4;
+	case E6809_IDX_DEC:
+		*r -= pb->offset;
+		ea = *r;
 		break;
-	case 0x9b: case 0xbb:
-	case 0xdb: case 0xfb:
-		/* [D,R] */
-
-		ea = read16 (*rptr_xyus[r] + get_reg_d ());
-		*cycles += 7;
+	case E6809_IDX_A:
+		ea = *r + sign_extend (cpu->reg_a);
 		break;
-	case 0x8c: case 0xac:
-	case 0xcc: case 0xec:
-		/* byte, PC */
-
-		r = sign_extend (pc_read8 ());
-		ea = reg_pc + r;
-		*cycles += 1;
+	case E6809_IDX_B:
+		ea = *r + sign_extend (cpu->reg_b);
 		break;
-	case 0x9c: case 0xbc:
-	case 0xdc: case 0xfc:
-		/* [byte, PC] */
-
-		r = sign_extend (pc_read8 ());
-		ea = read16 (reg_pc + r);
-		*cycles += 4;
+	case E6809_IDX_D:
+		ea = *r + get_reg_d (cpu);
 		break;
-	case 0x8d: case 0xad:
-	case 0xcd: case 0xed:
-		/* word, PC */
-
-		r = pc_read16 ();
-		ea = reg_pc + r;
-		*cycles += 5;
+	case E6809_IDX_OFF8:
+		ea = sign_extend (pc_read8 (cpu));
+		ea += *r;
 		break;
-	case 0x9d: case 0xbd:
-	case 0xdd: case 0xfd:
-		/* [word, PC] */
-
-		r = pc_read16 ();
-		ea = read16 (reg_pc + r);
-		*cycles += 8;
+	case E6809_IDX_OFF16:
+		ea = pc_read16 (cpu);
+		ea += *r;
 		break;
-	case 0x9f:
-		/* [address] */
-
-		ea = read16 (pc_read16 ());
-		*cycles += 5;
+	case E6809_IDX_EXT:
+		ea = pc_read16 (cpu);
 		break;
 	default:
 		printf ("undefined post-byte\n");
-		ea=0; // to avoid a compiler warning
-		break;
+		return 0;
+	}
+
+	if (pb->indirect) {
+		ea = read16 (cpu, ea);
 	}
 
+	*cycles += pb->cycles;
+
 	return ea;
 }
 
@@ -517,7 +610,7 @@ static einline unsigned short  ea_indexed (unsigned short  *cycles)
  * essentially (0 - data).
  */
 
-static einline unsigned short  inst_neg (unsigned short  data)
+static einline unsigned short  inst_neg (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  i0, i1, r;
 
@@ -525,27 +618,23 @@ static einline unsigned short  inst_neg (unsigned short  data)
 	i1 = ~data;
 	r = i0 + i1 + 1;
 
-	set_cc (FLAG_H, test_c (i0 << 4, i1 << 4, r << 4, 0));
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
-	set_cc (FLAG_C, test_c (i0, i1, r, 1));
+	cc_defer (cpu, CC_SUB8, FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
 
 /* instruction: com */
 
-static einline unsigned short  inst_com (unsigned short  data)
+static einline unsigned short  inst_com (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  r;
 
 	r = ~data;
 
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, 0);
-	set_cc (FLAG_C, 1);
+	set_cc (cpu, FLAG_N, test_n (r));
+	set_cc (cpu, FLAG_Z, test_z8 (r));
+	set_cc (cpu, FLAG_V, 0);
+	set_cc (cpu, FLAG_C, 1);
 
 	return r;
 }
@@ -554,15 +643,15 @@ static einline unsigned short  inst_com (unsigned short  data)
  * cannot be faked as an add or substract.
  */
 
-static einline unsigned short  inst_lsr (unsigned short  data)
+static einline unsigned short  inst_lsr (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  r;
 
 	r = (data >> 1) & 0x7f;
 
-	set_cc (FLAG_N, 0);
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_C, data & 1);
+	set_cc (cpu, FLAG_N, 0);
+	set_cc (cpu, FLAG_Z, test_z8 (r));
+	set_cc (cpu, FLAG_C, data & 1);
 
 	return r;
 }
@@ -571,16 +660,16 @@ static einline unsigned short  inst_lsr (unsigned short  data)
  * cannot be faked as an add or substract.
  */
 
-static einline unsigned short  inst_ror (unsigned short  data)
+static einline unsigned short  inst_ror (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  r, c;
 
-	c = get_cc (FLAG_C);
+	c = get_cc (cpu, FLAG_C);
 	r = ((data >> 1) & 0x7f) | (c << 7);
 
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_C, data & 1);
+	set_cc (cpu, FLAG_N, test_n (r));
+	set_cc (cpu, FLAG_Z, test_z8 (r));
+	set_cc (cpu, FLAG_C, data & 1);
 
 	return r;
 }
@@ -589,15 +678,15 @@ static einline unsigned short  inst_ror (unsigned short  data)
  * cannot be faked as an add or substract.
  */
 
-static einline unsigned short  inst_asr (unsigned short  data)
+static einline unsigned short  inst_asr (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  r;
 
 	r = ((data >> 1) & 0x7f) | (data & 0x80);
 
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_C, data & 1);
+	set_cc (cpu, FLAG_N, test_n (r));
+	set_cc (cpu, FLAG_Z, test_z8 (r));
+	set_cc (cpu, FLAG_C, data & 1);
 
 	return r;
 }
@@ -606,7 +695,7 @@ static einline unsigned short  inst_asr (unsigned short  data)
  * essentially (data + data). simple addition.
  */
 
-static einline unsigned short  inst_asl (unsigned short  data)
+static einline unsigned short  inst_asl (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  i0, i1, r;
 
@@ -614,11 +703,7 @@ static einline unsigned short  inst_asl (unsigned short  data)
 	i1 = data;
 	r = i0 + i1;
 
-	set_cc (FLAG_H, test_c (i0 << 4, i1 << 4, r << 4, 0));
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
-	set_cc (FLAG_C, test_c (i0, i1, r, 0));
+	cc_defer (cpu, CC_ADD8, FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
@@ -627,19 +712,16 @@ static einline unsigned short  inst_asl (unsigned short  data)
  * essentially (data + data + carry). addition with carry.
  */
 
-static einline unsigned short  inst_rol (unsigned short  data)
+static einline unsigned short  inst_rol (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  i0, i1, c, r;
 
 	i0 = data;
 	i1 = data;
-	c = get_cc (FLAG_C);
+	c = get_cc (cpu, FLAG_C);
 	r = i0 + i1 + c;
 
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
-	set_cc (FLAG_C, test_c (i0, i1, r, 0));
+	cc_defer (cpu, CC_ADD8, FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
@@ -648,7 +730,7 @@ static einline unsigned short  inst_rol (unsigned short  data)
  * essentially (data - 1).
  */
 
-static einline unsigned short  inst_dec (unsigned short  data)
+static einline unsigned short  inst_dec (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  i0, i1, r;
 
@@ -656,9 +738,7 @@ static einline unsigned short  inst_dec (unsigned short  data)
 	i1 = 0xff;
 	r = i0 + i1;
 
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
+	cc_defer (cpu, CC_ADD8, FLAG_N | FLAG_Z | FLAG_V, i0, i1, r);
 
 	return r;
 }
@@ -667,7 +747,7 @@ static einline unsigned short  inst_dec (unsigned short  data)
  * essentially (data + 1).
  */
 
-static einline unsigned short  inst_inc (unsigned short  data)
+static einline unsigned short  inst_inc (e6809_t *cpu, unsigned short  data)
 {
 	unsigned short  i0, i1, r;
 
@@ -675,42 +755,36 @@ static einline unsigned short  inst_inc (unsigned short  data)
 	i1 = 1;
 	r = i0 + i1;
 
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
+	cc_defer (cpu, CC_ADD8, FLAG_N | FLAG_Z | FLAG_V, i0, i1, r);
 
 	return r;
 }
 
 /* instruction: tst */
 
-static einline void inst_tst8 (unsigned short  data)
+static einline void inst_tst8 (e6809_t *cpu, unsigned short  data)
 {
-	set_cc (FLAG_N, test_n (data));
-	set_cc (FLAG_Z, test_z8 (data));
-	set_cc (FLAG_V, 0);
+	cc_defer (cpu, CC_TST8, FLAG_N | FLAG_Z | FLAG_V, 0, 0, data);
 }
 
-static einline void inst_tst16 (unsigned short  data)
+static einline void inst_tst16 (e6809_t *cpu, unsigned short  data)
 {
-	set_cc (FLAG_N, test_n (data >> 8));
-	set_cc (FLAG_Z, test_z16 (data));
-	set_cc (FLAG_V, 0);
+	cc_defer (cpu, CC_TST16, FLAG_N | FLAG_Z | FLAG_V, 0, 0, data);
 }
 
 /* instruction: clr */
 
-static einline void inst_clr (void)
+static einline void inst_clr (e6809_t *cpu)
 {
-	set_cc (FLAG_N, 0);
-	set_cc (FLAG_Z, 1);
-	set_cc (FLAG_V, 0);
-	set_cc (FLAG_C, 0);
+	set_cc (cpu, FLAG_N, 0);
+	set_cc (cpu, FLAG_Z, 1);
+	set_cc (cpu, FLAG_V, 0);
+	set_cc (cpu, FLAG_C, 0);
 }
 
 /* instruction: suba/subb */
 
-static einline unsigned short  inst_sub8 (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_sub8 (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  i0, i1, r;
 
@@ -718,11 +792,7 @@ static einline unsigned short  inst_sub8 (unsigned short  data0, unsigned short
 	i1 = ~data1;
 	r = i0 + i1 + 1;
 
-	set_cc (FLAG_H, test_c (i0 << 4, i1 << 4, r << 4, 0));
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
-	set_cc (FLAG_C, test_c (i0, i1, r, 1));
+	cc_defer (cpu, CC_SUB8, FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
@@ -731,20 +801,16 @@ static einline unsigned short  inst_sub8 (unsigned short  data0, unsigned short
  * only 8-bit version, 16-bit version not needed.
  */
 
-static einline unsigned short  inst_sbc (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_sbc (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  i0, i1, c, r;
 
 	i0 = data0;
 	i1 = ~data1;
-	c = 1 - get_cc (FLAG_C);
+	c = 1 - get_cc (cpu, FLAG_C);
 	r = i0 + i1 + c;
 
-	set_cc (FLAG_H, test_c (i0 << 4, i1 << 4, r << 4, 0));
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
-	set_cc (FLAG_C, test_c (i0, i1, r, 1));
+	cc_defer (cpu, CC_SUB8, FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
@@ -753,13 +819,13 @@ static einline unsigned short  inst_sbc (unsigned short  data0, unsigned short
  * only 8-bit version, 16-bit version not needed.
  */
 
-static einline unsigned short  inst_and (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_and (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  r;
 
 	r = data0 & data1;
 
-	inst_tst8 (r);
+	inst_tst8 (cpu, r);
 
 	return r;
 }
@@ -768,13 +834,13 @@ static einline unsigned short  inst_and (unsigned short  data0, unsigned short
  * only 8-bit version, 16-bit version not needed.
  */
 
-static einline unsigned short  inst_eor (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_eor (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  r;
 
 	r = data0 ^ data1;
 
-	inst_tst8 (r);
+	inst_tst8 (cpu, r);
 
 	return r;
 }
@@ -783,20 +849,16 @@ static einline unsigned short  inst_eor (unsigned short  data0, unsigned short
  * only 8-bit version, 16-bit version not needed.
  */
 
-static einline unsigned short  inst_adc (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_adc (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  i0, i1, c, r;
 
 	i0 = data0;
 	i1 = data1;
-	c = get_cc (FLAG_C);
+	c = get_cc (cpu, FLAG_C);
 	r = i0 + i1 + c;
 
-	set_cc (FLAG_H, test_c (i0 << 4, i1 << 4, r << 4, 0));
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
-	set_cc (FLAG_C, test_c (i0, i1, r, 0));
+	cc_defer (cpu, CC_ADD8, FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
@@ -805,20 +867,20 @@ static einline unsigned short  inst_adc (unsigned short  data0, unsigned short
  * only 8-bit version, 16-bit version not needed.
  */
 
-static einline unsigned short  inst_or (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_or (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  r;
 
 	r = data0 | data1;
 
-	inst_tst8 (r);
+	inst_tst8 (cpu, r);
 
 	return r;
 }
 
 /* instruction: adda/addb */
 
-static einline unsigned short  inst_add8 (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_add8 (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  i0, i1, r;
 
@@ -826,18 +888,14 @@ static einline unsigned short  inst_add8 (unsigned short  data0, unsigned short
 	i1 = data1;
 	r = i0 + i1;
 
-	set_cc (FLAG_H, test_c (i0 << 4, i1 << 4, r << 4, 0));
-	set_cc (FLAG_N, test_n (r));
-	set_cc (FLAG_Z, test_z8 (r));
-	set_cc (FLAG_V, test_v (i0, i1, r));
-	set_cc (FLAG_C, test_c (i0, i1, r, 0));
+	cc_defer (cpu, CC_ADD8, FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
 
 /* instruction: addd */
 
-static einline unsigned short  inst_add16 (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_add16 (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  i0, i1, r;
 
@@ -845,17 +903,14 @@ static einline unsigned short  inst_add16 (unsigned short  data0, unsigned short
 	i1 = data1;
 	r = i0 + i1;
 
-	set_cc (FLAG_N, test_n (r >> 8));
-	set_cc (FLAG_Z, test_z16 (r));
-	set_cc (FLAG_V, test_v (i0 >> 8, i1 >> 8, r >> 8));
-	set_cc (FLAG_C, test_c (i0 >> 8, i1 >> 8, r >> 8, 0));
+	cc_defer (cpu, CC_ADD16, FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
 
 /* instruction: subd */
 
-static einline unsigned short  inst_sub16 (unsigned short  data0, unsigned short  data1)
+static einline unsigned short  inst_sub16 (e6809_t *cpu, unsigned short  data0, unsigned short  data1)
 {
 	unsigned short  i0, i1, r;
 
@@ -863,174 +918,169 @@ static einline unsigned short  inst_sub16 (unsigned short  data0, unsigned short
 	i1 = ~data1;
 	r = i0 + i1 + 1;
 
-	set_cc (FLAG_N, test_n (r >> 8));
-	set_cc (FLAG_Z, test_z16 (r));
-	set_cc (FLAG_V, test_v (i0 >> 8, i1 >> 8, r >> 8));
-	set_cc (FLAG_C, test_c (i0 >> 8, i1 >> 8, r >> 8, 1));
+	cc_defer (cpu, CC_SUB16, FLAG_N | FLAG_Z | FLAG_V | FLAG_C, i0, i1, r);
 
 	return r;
 }
 
 /* instruction: 8-bit offset branch */
 
-static einline void inst_bra8 (unsigned short  test, unsigned short  op, unsigned short  *cycles)
+static einline void inst_bra8 (e6809_t *cpu, unsigned short  test, unsigned short  op)
 {
 	unsigned short  offset, mask;
 
-	offset = pc_read8 ();
+	offset = pc_read8 (cpu);
 
 	/* trying to avoid an if statement */
 
 	mask = (test ^ (op & 1)) - 1; /* 0xffff when taken, 0 when not taken */
-	reg_pc += sign_extend (offset) & mask;
-
-	*cycles += 3;
+	cpu->reg_pc += sign_extend (offset) & mask;
 }
 
 /* instruction: 16-bit offset branch */
 
-static einline void inst_bra16 (unsigned short  test, unsigned short  op, unsigned short  *cycles)
+static einline void inst_bra16 (e6809_t *cpu, unsigned short  test, unsigned short  op, unsigned short  *cycles)
 {
 	unsigned short  offset, mask;
 
-	offset = pc_read16 ();
+	offset = pc_read16 (cpu);
 
 	/* trying to avoid an if statement */
 
 	mask = (test ^ (op & 1)) - 1; /* 0xffff when taken, 0 when not taken */
-	reg_pc += offset & mask;
+	cpu->reg_pc += offset & mask;
 
-	*cycles += 5 - mask;
+	*cycles += mask & 1; /* a taken long branch costs one more cycle */
 }
 
 /* instruction: pshs/pshu */
 
-static einline void inst_psh (unsigned short  op, unsigned short  *sp,
+static einline void inst_psh (e6809_t *cpu, unsigned short  op, unsigned short  *sp,
 					   unsigned short  data, unsigned short  *cycles)
 {
 	if (op & 0x80) {
-		push16 (sp, reg_pc);
+		push16 (cpu, sp, cpu->reg_pc);
 		*cycles += 2;
 	}
 
 	if (op & 0x40) {
 		/* either s or u */
-		push16 (sp, data);
+		push16 (cpu, sp, data);
 		*cycles += 2;
 	}
 
 	if (op & 0x20) {
-		push16 (sp, reg_y);
+		push16 (cpu, sp, cpu->reg_y);
 		*cycles += 2;
 	}
 
 	if (op & 0x10) {
-		push16 (sp, reg_x);
+		push16 (cpu, sp, cpu->reg_x);
 		*cycles += 2;
 	}
 
 	if (op & 0x08) {
-		push8 (sp, reg_dp);
+		push8 (cpu, sp, cpu->reg_dp);
 		*cycles += 1;
 	}
 
 	if (op & 0x04) {
-		push8 (sp, reg_b);
+		push8 (cpu, sp, cpu->reg_b);
 		*cycles += 1;
 	}
 
 	if (op & 0x02) {
-		push8 (sp, reg_a);
+		push8 (cpu, sp, cpu->reg_a);
 		*cycles += 1;
 	}
 
 	if (op & 0x01) {
-		push8 (sp, reg_cc);
+		push8 (cpu, sp, get_reg_cc (cpu));
 		*cycles += 1;
 	}
 }
 
 /* instruction: puls/pulu */
 
-static einline void inst_pul (unsigned short  op, unsigned short  *sp, unsigned short  *osp,
+static einline void inst_pul (e6809_t *cpu, unsigned short  op, unsigned short  *sp, unsigned short  *osp,
 					   unsigned short  *cycles)
 {
 	if (op & 0x01) {
-		reg_cc = pull8 (sp);
+		set_reg_cc (cpu, pull8 (cpu, sp));
 		*cycles += 1;
 	}
 
 	if (op & 0x02) {
-		reg_a = pull8 (sp);
+		cpu->reg_a = pull8 (cpu, sp);
 		*cycles += 1;
 	}
 
 	if (op & 0x04) {
-		reg_b = pull8 (sp);
+		cpu->reg_b = pull8 (cpu, sp);
 		*cycles += 1;
 	}
 
 	if (op & 0x08) {
-		reg_dp = pull8 (sp);
+		cpu->reg_dp = pull8 (cpu, sp);
 		*cycles += 1;
 	}
 
 	if (op & 0x10) {
-		reg_x = pull16 (sp);
+		cpu->reg_x = pull16 (cpu, sp);
 		*cycles += 2;
 	}
 
 	if (op & 0x20) {
-		reg_y = pull16 (sp);
+		cpu->reg_y = pull16 (cpu, sp);
 		*cycles += 2;
 	}
 
 	if (op & 0x40) {
 		/* either s or u */
-		*osp = pull16 (sp);
+		*osp = pull16 (cpu, sp);
 		*cycles += 2;
 	}
 
 	if (op & 0x80) {
-		reg_pc = pull16 (sp);
+		cpu->reg_pc = pull16 (cpu, sp);
 		*cycles += 2;
 	}
 }
 
-static einline unsigned short  exgtfr_read (unsigned short  reg)
+static einline unsigned short  exgtfr_read (e6809_t *cpu, unsigned short  reg)
 {
 	unsigned short  data;
 
 	switch (reg) {
 	case 0x0:
-		data = get_reg_d ();
+		data = get_reg_d (cpu);
 		break;
 	case 0x1:
-		data = reg_x;
+		data = cpu->reg_x;
 		break;
 	case 0x2:
-		data = reg_y;
+		data = cpu->reg_y;
 		break;
 	case 0x3:
-		data = reg_u;
+		data = cpu->reg_u;
 		break;
 	case 0x4:
-		data = reg_s;
+		data = cpu->reg_s;
 		break;
 	case 0x5:
-		data = reg_pc;
+		data = cpu->reg_pc;
 		break;
 	case 0x8:
-		data = 0xff00 | reg_a;
+		data = 0xff00 | cpu->reg_a;
 		break;
 	case 0x9:
-		data = 0xff00 | reg_b;
+		data = 0xff00 | cpu->reg_b;
 		break;
 	case 0xa:
-		data = 0xff00 | reg_cc;
+		data = 0xff00 | get_reg_cc (cpu);
 		break;
 	case 0xb:
-		data = 0xff00 | reg_dp;
+		data = 0xff00 | cpu->reg_dp;
 		break;
 	default:
 		data = 0xffff;
@@ -1041,38 +1091,38 @@ static einline unsigned short  exgtfr_read (unsigned short  reg)
 	return data;
 }
 
-static einline void exgtfr_write (unsigned short  reg, unsigned short  data)
+static einline void exgtfr_write (e6809_t *cpu, unsigned short  reg, unsigned short  data)
 {
 	switch (reg) {
 	case 0x0:
-		set_reg_d (data);
+		set_reg_d (cpu, data);
 		break;
 	case 0x1:
-		reg_x = data;
+		cpu->reg_x = data;
 		break;
 	case 0x2:
-		reg_y = data;
+		cpu->reg_y = data;
 		break;
 	case 0x3:
-		reg_u = data;
+		cpu->reg_u = data;
 		break;
 	case 0x4:
-		reg_s = data;
+		cpu->reg_s = data;
 		break;
 	case 0x5:
-		reg_pc = data;
+		cpu->reg_pc = data;
 		break;
 	case 0x8:
-		reg_a = data;
+		cpu->reg_a = data;
 		break;
 	case 0x9:
-		reg_b = data;
+		cpu->reg_b = data;
 		break;
 	case 0xa:
-		reg_cc = data;
+		set_reg_cc (cpu, data);
 		break;
 	case 0xb:
-		reg_dp = data;
+		cpu->reg_dp = data;
 		break;
 	default:
 		printf ("illegal exgtfr reg %.1x\n", reg);
@@ -1082,1932 +1132,4226 @@ static einline void exgtfr_write (unsigned short  reg, unsigned short  data)
 
 /* instruction: exg */
 
-static einline void inst_exg (void)
+static einline void inst_exg (e6809_t *cpu)
 {
 	unsigned short  op, tmp;
 
-	op = pc_read8 ();
+	op = pc_read8 (cpu);
 
-	tmp = exgtfr_read (op & 0xf);
-	exgtfr_write (op & 0xf, exgtfr_read (op >> 4));
-	exgtfr_write (op >> 4, tmp);
+	tmp = exgtfr_read (cpu, op & 0xf);
+	exgtfr_write (cpu, op & 0xf, exgtfr_read (cpu, op >> 4));
+	exgtfr_write (cpu, op >> 4, tmp);
 }
 
 /* instruction: tfr */
 
-static einline void inst_tfr (void)
+static einline void inst_tfr (e6809_t *cpu)
 {
 	unsigned short op;
 
-	op = pc_read8 ();
+	op = pc_read8 (cpu);
 
-	exgtfr_write (op & 0xf, exgtfr_read (op >> 4));
+	exgtfr_write (cpu, op & 0xf, exgtfr_read (cpu, op >> 4));
 }
 
 /* reset the 6809 */
 
-void e6809_reset (void)
+void e6809_reset (e6809_t *cpu)
 {
-	reg_x = 0;
-	reg_y = 0;
-	reg_u = 0;
-	reg_s = 0;
+	cpu->reg_x = 0;
+	cpu->reg_y = 0;
+	cpu->reg_u = 0;
+	cpu->reg_s = 0;
+
+	cpu->reg_a = 0;
+	cpu->reg_b = 0;
 
-	reg_a = 0;
-	reg_b = 0;
+	cpu->reg_dp = 0;
 
-	reg_dp = 0;
+	set_reg_cc (cpu, FLAG_I | FLAG_F);
+	cpu->irq_status = IRQ_NORMAL;
+	cpu->run_limit = 0;
 
-	reg_cc = FLAG_I | FLAG_F;
-	irq_status = IRQ_NORMAL;
+	/* the contents of the cartridge might have changed */
 
-	reg_pc = read16 (0xfffe);
+	dcache_flush (cpu);
+
+	cpu->reg_pc = read16 (cpu, 0xfffe);
 }
 
 
-unsigned int ins_0x00(void) {
+unsigned int ins_0x00(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_neg (read8 (ea));
-		write8 (ea, r);
-		return 6;
+		ea = ea_direct (cpu);
+		r = inst_neg (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
-unsigned int ins_0x40(void) {
-		reg_a = inst_neg (reg_a);
-		return 2;
+unsigned int ins_0x40(e6809_t *cpu) {
+		cpu->reg_a = inst_neg (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x50(void) {
-		reg_b = inst_neg (reg_b);
-		return 2;
+unsigned int ins_0x50(e6809_t *cpu) {
+		cpu->reg_b = inst_neg (cpu, cpu->reg_b);
+		return 0;
 }
 		
-unsigned int ins_0x60(void) {
+unsigned int ins_0x60(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
 
-		ea = ea_indexed (&cycles);
-		r = inst_neg (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_neg (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;
 }
 
-unsigned int ins_0x70(void) {
+unsigned int ins_0x70(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_neg (read8 (ea));
-		write8 (ea, r);
-		return 7;
+		ea = ea_extended (cpu);
+		r = inst_neg (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
 	/* com, coma, comb */
-unsigned int ins_0x03(void) {
+unsigned int ins_0x03(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_com (read8 (ea));
-		write8 (ea, r);
-		return 6;
+		ea = ea_direct (cpu);
+		r = inst_com (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
-unsigned int ins_0x43(void) {
-		reg_a = inst_com (reg_a);
-		return 2;
+unsigned int ins_0x43(e6809_t *cpu) {
+		cpu->reg_a = inst_com (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x53(void) {
-		reg_b = inst_com (reg_b);
-		return 2;
+unsigned int ins_0x53(e6809_t *cpu) {
+		cpu->reg_b = inst_com (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0x63(void) {
+unsigned int ins_0x63(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
 
-		ea = ea_indexed (&cycles);
-		r = inst_com (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_com (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;
 }
 
-unsigned int ins_0x73(void) {
+unsigned int ins_0x73(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_com (read8 (ea));
-		write8 (ea, r);
-		return 7;
+		ea = ea_extended (cpu);
+		r = inst_com (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
 	/* lsr, lsra, lsrb */
-unsigned int ins_0x04(void) {
+unsigned int ins_0x04(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_lsr (read8 (ea));
-		write8 (ea, r);
-		return 6;
+		ea = ea_direct (cpu);
+		r = inst_lsr (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
-unsigned int ins_0x44(void) {
-		reg_a = inst_lsr (reg_a);
-		return 2;
+unsigned int ins_0x44(e6809_t *cpu) {
+		cpu->reg_a = inst_lsr (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x54(void) {
-		reg_b = inst_lsr (reg_b);
-		return 2;
+unsigned int ins_0x54(e6809_t *cpu) {
+		cpu->reg_b = inst_lsr (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0x64(void) {
+unsigned int ins_0x64(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
-		ea = ea_indexed (&cycles);
-		r = inst_lsr (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_lsr (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;
 }
 
-unsigned int ins_0x74(void) {
+unsigned int ins_0x74(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_lsr (read8 (ea));
-		write8 (ea, r);
-		return 7;
+		ea = ea_extended (cpu);
+		r = inst_lsr (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
 	/* ror, rora, rorb */
-unsigned int ins_0x06(void) {
+unsigned int ins_0x06(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_ror (read8 (ea));
-		write8 (ea, r);
-		return 6;
+		ea = ea_direct (cpu);
+		r = inst_ror (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
-unsigned int ins_0x46(void) {
-		reg_a = inst_ror (reg_a);
-		return 2;
+unsigned int ins_0x46(e6809_t *cpu) {
+		cpu->reg_a = inst_ror (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x56(void) {
-		reg_b = inst_ror (reg_b);
-		return 2;
+unsigned int ins_0x56(e6809_t *cpu) {
+		cpu->reg_b = inst_ror (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0x66(void) {
+unsigned int ins_0x66(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
-		ea = ea_indexed (&cycles);
-		r = inst_ror (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_ror (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;
 }
 
-unsigned int ins_0x76(void) {
+unsigned int ins_0x76(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_ror (read8 (ea));
-		write8 (ea, r);
-		return 7;
+		ea = ea_extended (cpu);
+		r = inst_ror (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
 	/* asr, asra, asrb */
-unsigned int ins_0x07(void) {
+unsigned int ins_0x07(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_asr (read8 (ea));
-		write8 (ea, r);
-		return 6;
+		ea = ea_direct (cpu);
+		r = inst_asr (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
-unsigned int ins_0x47(void) {
-		reg_a = inst_asr (reg_a);
-		return 2;
+unsigned int ins_0x47(e6809_t *cpu) {
+		cpu->reg_a = inst_asr (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x57(void) {
-		reg_b = inst_asr (reg_b);
-		return 2;
+unsigned int ins_0x57(e6809_t *cpu) {
+		cpu->reg_b = inst_asr (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0x67(void) {
+unsigned int ins_0x67(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
-		ea = ea_indexed (&cycles);
-		r = inst_asr (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_asr (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;
 }
 
-unsigned int ins_0x77(void) {
+unsigned int ins_0x77(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_asr (read8 (ea));
-		write8 (ea, r);
-		return 7;
+		ea = ea_extended (cpu);
+		r = inst_asr (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
 	/* asl, asla, aslb */
-unsigned int ins_0x08(void) {
+unsigned int ins_0x08(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_asl (read8 (ea));
-		write8 (ea, r);
-		return 6;
+		ea = ea_direct (cpu);
+		r = inst_asl (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
-unsigned int ins_0x48(void) {
-		reg_a = inst_asl (reg_a);
-		return 2;
+unsigned int ins_0x48(e6809_t *cpu) {
+		cpu->reg_a = inst_asl (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x58(void) {
-		reg_b = inst_asl (reg_b);
-		return 2;
+unsigned int ins_0x58(e6809_t *cpu) {
+		cpu->reg_b = inst_asl (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0x68(void) {
+unsigned int ins_0x68(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
-		ea = ea_indexed (&cycles);
-		r = inst_asl (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_asl (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;
 }
 
-unsigned int ins_0x78(void) {
+unsigned int ins_0x78(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_asl (read8 (ea));
-		write8 (ea, r);
-		return 7;
+		ea = ea_extended (cpu);
+		r = inst_asl (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
 	/* rol, rola, rolb */
-unsigned int ins_0x09(void) {
+unsigned int ins_0x09(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_rol (read8 (ea));
-		write8 (ea, r);
-		return 6;
+		ea = ea_direct (cpu);
+		r = inst_rol (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
-unsigned int ins_0x49(void) {
-		reg_a = inst_rol (reg_a);
-		return 2;
+unsigned int ins_0x49(e6809_t *cpu) {
+		cpu->reg_a = inst_rol (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x59(void) {
-		reg_b = inst_rol (reg_b);
-		return 2;
+unsigned int ins_0x59(e6809_t *cpu) {
+		cpu->reg_b = inst_rol (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0x69(void) {
+unsigned int ins_0x69(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
-		ea = ea_indexed (&cycles);
-		r = inst_rol (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_rol (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;
 }
 
-unsigned int ins_0x79(void) {
+unsigned int ins_0x79(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_rol (read8 (ea));
-		write8 (ea, r);
-		return 7;
+		ea = ea_extended (cpu);
+		r = inst_rol (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
 	/* dec, deca, decb */
-unsigned int ins_0x0a(void) {
+unsigned int ins_0x0a(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_dec (read8 (ea));
-		write8 (ea, r);
-		return 6;
+		ea = ea_direct (cpu);
+		r = inst_dec (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;
 }
 
-unsigned int ins_0x4a(void) {
-		reg_a = inst_dec (reg_a);
-		return 2;
+unsigned int ins_0x4a(e6809_t *cpu) {
+		cpu->reg_a = inst_dec (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x5a(void) {
-		reg_b = inst_dec (reg_b);
-		return 2;
+unsigned int ins_0x5a(e6809_t *cpu) {
+		cpu->reg_b = inst_dec (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0x6a(void) {
+unsigned int ins_0x6a(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
 
-		ea = ea_indexed (&cycles);
-		r = inst_dec (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;}
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_dec (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;}
 		
-unsigned int ins_0x7a(void) {
+unsigned int ins_0x7a(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_dec (read8 (ea));
-		write8 (ea, r);
-		return 7;}
+		ea = ea_extended (cpu);
+		r = inst_dec (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;}
 		
 	/* inc, inca, incb */
-unsigned int ins_0x0c(void) {
+unsigned int ins_0x0c(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_direct ();
-		r = inst_inc (read8 (ea));
-		write8 (ea, r);
-		return 6;}
+		ea = ea_direct (cpu);
+		r = inst_inc (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;}
 		
-unsigned int ins_0x4c(void) {
-		reg_a = inst_inc (reg_a);
-		return 2;
+unsigned int ins_0x4c(e6809_t *cpu) {
+		cpu->reg_a = inst_inc (cpu, cpu->reg_a);
+		return 0;
 }
-unsigned int ins_0x5c(void) {
-		reg_b = inst_inc (reg_b);
-		return 2;
+unsigned int ins_0x5c(e6809_t *cpu) {
+		cpu->reg_b = inst_inc (cpu, cpu->reg_b);
+		return 0;
 }
-unsigned int ins_0x6c(void) {
+unsigned int ins_0x6c(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea, r;
 
-		ea = ea_indexed (&cycles);
-		r = inst_inc (read8 (ea));
-		write8 (ea, r);
-		return cycles + 6;}
+		ea = ea_indexed (cpu, &cycles);
+		r = inst_inc (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return cycles;}
 		
-unsigned int ins_0x7c(void) {
+unsigned int ins_0x7c(e6809_t *cpu) {
 	unsigned short  ea, r;
-		ea = ea_extended ();
-		r = inst_inc (read8 (ea));
-		write8 (ea, r);
-		return 7;}
+		ea = ea_extended (cpu);
+		r = inst_inc (cpu, read8 (cpu, ea));
+		write8 (cpu, ea, r);
+		return 0;}
 		
 	/* tst, tsta, tstb */
-unsigned int ins_0x0d(void) {
+unsigned int ins_0x0d(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		inst_tst8 (read8 (ea));
-		return 6;}
+		ea = ea_direct (cpu);
+		inst_tst8 (cpu, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0x4d(void) {
-		inst_tst8 (reg_a);
-		return 2;
+unsigned int ins_0x4d(e6809_t *cpu) {
+		inst_tst8 (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x5d(void) {
-		inst_tst8 (reg_b);
-		return 2;
+unsigned int ins_0x5d(e6809_t *cpu) {
+		inst_tst8 (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0x6d(void) {
+unsigned int ins_0x6d(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		inst_tst8 (read8 (ea));
-		return cycles + 6;}
+		ea = ea_indexed (cpu, &cycles);
+		inst_tst8 (cpu, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0x7d(void) {
+unsigned int ins_0x7d(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		inst_tst8 (read8 (ea));
-		return 7;}
+		ea = ea_extended (cpu);
+		inst_tst8 (cpu, read8 (cpu, ea));
+		return 0;}
 		
 	/* jmp */
-unsigned int ins_0x0e(void) {
-		reg_pc = ea_direct ();
-		return 3;}
+unsigned int ins_0x0e(e6809_t *cpu) {
+		cpu->reg_pc = ea_direct (cpu);
+		return 0;}
 		
-unsigned int ins_0x6e(void) {
+unsigned int ins_0x6e(e6809_t *cpu) {
 	unsigned short  cycles = 0;
-		reg_pc = ea_indexed (&cycles);
-		return cycles + 3;}
+		cpu->reg_pc = ea_indexed (cpu, &cycles);
+		return cycles;}
 		
-unsigned int ins_0x7e(void) {
-		reg_pc = ea_extended ();
-		return 4;}
+unsigned int ins_0x7e(e6809_t *cpu) {
+		cpu->reg_pc = ea_extended (cpu);
+		return 0;}
 		
 	/* clr */
-unsigned int ins_0x0f(void) {
+unsigned int ins_0x0f(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		inst_clr ();
-		write8 (ea, 0);
-		return 6;}
-		
-unsigned int ins_0x4f(void) {
-		inst_clr ();
-		reg_a = 0;
-		return 2;
+		ea = ea_direct (cpu);
+		inst_clr (cpu);
+		write8 (cpu, ea, 0);
+		return 0;}
+		
+unsigned int ins_0x4f(e6809_t *cpu) {
+		inst_clr (cpu);
+		cpu->reg_a = 0;
+		return 0;
 }
 
-unsigned int ins_0x5f(void) {
-		inst_clr ();
-		reg_b = 0;
-		return 2;
+unsigned int ins_0x5f(e6809_t *cpu) {
+		inst_clr (cpu);
+		cpu->reg_b = 0;
+		return 0;
 }
 
-unsigned int ins_0x6f(void) {
+unsigned int ins_0x6f(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		inst_clr ();
-		write8 (ea, 0);
-		return cycles + 6;}
+		ea = ea_indexed (cpu, &cycles);
+		inst_clr (cpu);
+		write8 (cpu, ea, 0);
+		return cycles;}
 		
-unsigned int ins_0x7f(void) {
+unsigned int ins_0x7f(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		inst_clr ();
-		write8 (ea, 0);
-		return 7;}
+		ea = ea_extended (cpu);
+		inst_clr (cpu);
+		write8 (cpu, ea, 0);
+		return 0;}
 		
 	/* suba */
-unsigned int ins_0x80(void) {
-		reg_a = inst_sub8 (reg_a, pc_read8 ());
-		return 2;}
+unsigned int ins_0x80(e6809_t *cpu) {
+		cpu->reg_a = inst_sub8 (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;}
 
-unsigned int ins_0x90(void) {
+unsigned int ins_0x90(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_a = inst_sub8 (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_a = inst_sub8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xa0(void) {
+unsigned int ins_0xa0(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		reg_a = inst_sub8 (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_a = inst_sub8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xb0(void) {
+unsigned int ins_0xb0(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_a = inst_sub8 (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_a = inst_sub8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* subb */
-unsigned int ins_0xc0(void) {
-		reg_b = inst_sub8 (reg_b, pc_read8 ());
-		return 2;
+unsigned int ins_0xc0(e6809_t *cpu) {
+		cpu->reg_b = inst_sub8 (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0xd0(void) {
+unsigned int ins_0xd0(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_b = inst_sub8 (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_b = inst_sub8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xe0(void) {
+unsigned int ins_0xe0(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		reg_b = inst_sub8 (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_b = inst_sub8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xf0(void) {
+unsigned int ins_0xf0(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_b = inst_sub8 (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_b = inst_sub8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* cmpa */
-unsigned int ins_0x81(void) {
-		inst_sub8 (reg_a, pc_read8 ());
-		return 2;}
+unsigned int ins_0x81(e6809_t *cpu) {
+		inst_sub8 (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;}
 		
-unsigned int ins_0x91(void) {
+unsigned int ins_0x91(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		inst_sub8 (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		inst_sub8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xa1(void) {
+unsigned int ins_0xa1(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		inst_sub8 (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		inst_sub8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xb1(void) {
+unsigned int ins_0xb1(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		inst_sub8 (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		inst_sub8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* cmpb */
-unsigned int ins_0xc1(void) {
-		inst_sub8 (reg_b, pc_read8 ());
-		return 2;
+unsigned int ins_0xc1(e6809_t *cpu) {
+		inst_sub8 (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0xd1(void) {
+unsigned int ins_0xd1(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		inst_sub8 (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		inst_sub8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xe1(void) {
+unsigned int ins_0xe1(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		inst_sub8 (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		inst_sub8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xf1(void) {
+unsigned int ins_0xf1(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		inst_sub8 (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		inst_sub8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* sbca */
-unsigned int ins_0x82(void) {
-		reg_a = inst_sbc (reg_a, pc_read8 ());
-		return 2;
+unsigned int ins_0x82(e6809_t *cpu) {
+		cpu->reg_a = inst_sbc (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0x92(void) {
+unsigned int ins_0x92(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_a = inst_sbc (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_a = inst_sbc (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xa2(void) {
+unsigned int ins_0xa2(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		reg_a = inst_sbc (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_a = inst_sbc (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xb2(void) {
+unsigned int ins_0xb2(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_a = inst_sbc (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_a = inst_sbc (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* sbcb */
-unsigned int ins_0xc2(void) {
-		reg_b = inst_sbc (reg_b, pc_read8 ());
-		return 2;
+unsigned int ins_0xc2(e6809_t *cpu) {
+		cpu->reg_b = inst_sbc (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0xd2(void) {
+unsigned int ins_0xd2(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_b = inst_sbc (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_b = inst_sbc (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xe2(void) {
+unsigned int ins_0xe2(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		reg_b = inst_sbc (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_b = inst_sbc (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xf2(void) {
+unsigned int ins_0xf2(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_b = inst_sbc (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_b = inst_sbc (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* anda */
-unsigned int ins_0x84(void) {
-		reg_a = inst_and (reg_a, pc_read8 ());
-		return 2;
+unsigned int ins_0x84(e6809_t *cpu) {
+		cpu->reg_a = inst_and (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0x94(void) {
+unsigned int ins_0x94(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_a = inst_and (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_a = inst_and (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xa4(void) {
+unsigned int ins_0xa4(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		reg_a = inst_and (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_a = inst_and (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xb4(void) {
+unsigned int ins_0xb4(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_a = inst_and (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_a = inst_and (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* andb */
-unsigned int ins_0xc4(void) {
-		reg_b = inst_and (reg_b, pc_read8 ());
-		return 2;
+unsigned int ins_0xc4(e6809_t *cpu) {
+		cpu->reg_b = inst_and (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0xd4(void) {
+unsigned int ins_0xd4(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_b = inst_and (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_b = inst_and (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xe4(void) {
+unsigned int ins_0xe4(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		reg_b = inst_and (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_b = inst_and (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xf4(void) {
+unsigned int ins_0xf4(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_b = inst_and (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_b = inst_and (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* bita */
-unsigned int ins_0x85(void) {
-		inst_and (reg_a, pc_read8 ());
-		return 2;
+unsigned int ins_0x85(e6809_t *cpu) {
+		inst_and (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0x95(void) {
+unsigned int ins_0x95(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		inst_and (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		inst_and (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xa5(void) {
+unsigned int ins_0xa5(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		inst_and (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		inst_and (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xb5(void) {
+unsigned int ins_0xb5(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		inst_and (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		inst_and (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* bitb */
-unsigned int ins_0xc5(void) {
-		inst_and (reg_b, pc_read8 ());
-		return 2;
+unsigned int ins_0xc5(e6809_t *cpu) {
+		inst_and (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0xd5(void) {
+unsigned int ins_0xd5(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		inst_and (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		inst_and (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xe5(void) {
+unsigned int ins_0xe5(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
 
-		ea = ea_indexed (&cycles);
-		inst_and (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		inst_and (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xf5(void) {
+unsigned int ins_0xf5(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		inst_and (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		inst_and (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* lda */
-unsigned int ins_0x86(void) {
-		reg_a = pc_read8 ();
-		inst_tst8 (reg_a);
-		return 2;
+unsigned int ins_0x86(e6809_t *cpu) {
+		cpu->reg_a = pc_read8 (cpu);
+		inst_tst8 (cpu, cpu->reg_a);
+		return 0;
 }
 
-unsigned int ins_0x96(void) {
+unsigned int ins_0x96(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_a = read8 (ea);
-		inst_tst8 (reg_a);
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_a = read8 (cpu, ea);
+		inst_tst8 (cpu, cpu->reg_a);
+		return 0;}
 		
-unsigned int ins_0xa6(void) {
+unsigned int ins_0xa6(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_a = read8 (ea);
-		inst_tst8 (reg_a);
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_a = read8 (cpu, ea);
+		inst_tst8 (cpu, cpu->reg_a);
+		return cycles;}
 		
-unsigned int ins_0xb6(void) {
+unsigned int ins_0xb6(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_a = read8 (ea);
-		inst_tst8 (reg_a);
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_a = read8 (cpu, ea);
+		inst_tst8 (cpu, cpu->reg_a);
+		return 0;}
 		
 	/* ldb */
-unsigned int ins_0xc6(void) {
-		reg_b = pc_read8 ();
-		inst_tst8 (reg_b);
-		return 2;
+unsigned int ins_0xc6(e6809_t *cpu) {
+		cpu->reg_b = pc_read8 (cpu);
+		inst_tst8 (cpu, cpu->reg_b);
+		return 0;
 }
 
-unsigned int ins_0xd6(void) {
+unsigned int ins_0xd6(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_b = read8 (ea);
-		inst_tst8 (reg_b);
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_b = read8 (cpu, ea);
+		inst_tst8 (cpu, cpu->reg_b);
+		return 0;}
 		
-unsigned int ins_0xe6(void) {
+unsigned int ins_0xe6(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_b = read8 (ea);
-		inst_tst8 (reg_b);
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_b = read8 (cpu, ea);
+		inst_tst8 (cpu, cpu->reg_b);
+		return cycles;}
 		
-unsigned int ins_0xf6(void) {
+unsigned int ins_0xf6(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_b = read8 (ea);
-		inst_tst8 (reg_b);
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_b = read8 (cpu, ea);
+		inst_tst8 (cpu, cpu->reg_b);
+		return 0;}
 		
 	/* sta */
-unsigned int ins_0x97(void) {
+unsigned int ins_0x97(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		write8 (ea, reg_a);
-		inst_tst8 (reg_a);
-		return 4;}
+		ea = ea_direct (cpu);
+		write8 (cpu, ea, cpu->reg_a);
+		inst_tst8 (cpu, cpu->reg_a);
+		return 0;}
 		
-unsigned int ins_0xa7(void) {
+unsigned int ins_0xa7(e6809_t *cpu) {
 	unsigned short  ea;
 	unsigned short  cycles = 0;
 
-		ea = ea_indexed (&cycles);
-		write8 (ea, reg_a);
-		inst_tst8 (reg_a);
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		write8 (cpu, ea, cpu->reg_a);
+		inst_tst8 (cpu, cpu->reg_a);
+		return cycles;}
 		
-unsigned int ins_0xb7(void) {
+unsigned int ins_0xb7(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		write8 (ea, reg_a);
-		inst_tst8 (reg_a);
-		return 5;}
+		ea = ea_extended (cpu);
+		write8 (cpu, ea, cpu->reg_a);
+		inst_tst8 (cpu, cpu->reg_a);
+		return 0;}
 		
 	/* stb */
-unsigned int ins_0xd7(void) {
+unsigned int ins_0xd7(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		write8 (ea, reg_b);
-		inst_tst8 (reg_b);
-		return 4;}
+		ea = ea_direct (cpu);
+		write8 (cpu, ea, cpu->reg_b);
+		inst_tst8 (cpu, cpu->reg_b);
+		return 0;}
 		
-unsigned int ins_0xe7(void) {
+unsigned int ins_0xe7(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		write8 (ea, reg_b);
-		inst_tst8 (reg_b);
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		write8 (cpu, ea, cpu->reg_b);
+		inst_tst8 (cpu, cpu->reg_b);
+		return cycles;}
 		
-unsigned int ins_0xf7(void) {
+unsigned int ins_0xf7(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		write8 (ea, reg_b);
-		inst_tst8 (reg_b);
-		return 5;}
+		ea = ea_extended (cpu);
+		write8 (cpu, ea, cpu->reg_b);
+		inst_tst8 (cpu, cpu->reg_b);
+		return 0;}
 		
 	/* eora */
-unsigned int ins_0x88(void) {
-		reg_a = inst_eor (reg_a, pc_read8 ());
-		return 2;
+unsigned int ins_0x88(e6809_t *cpu) {
+		cpu->reg_a = inst_eor (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0x98(void) {
+unsigned int ins_0x98(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_a = inst_eor (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_a = inst_eor (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xa8(void) {
+unsigned int ins_0xa8(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_a = inst_eor (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_a = inst_eor (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xb8(void) {
+unsigned int ins_0xb8(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_a = inst_eor (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_a = inst_eor (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* eorb */
-unsigned int ins_0xc8(void) {
-		reg_b = inst_eor (reg_b, pc_read8 ());
-		return 2;
+unsigned int ins_0xc8(e6809_t *cpu) {
+		cpu->reg_b = inst_eor (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0xd8(void) {
+unsigned int ins_0xd8(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_b = inst_eor (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_b = inst_eor (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xe8(void) {
+unsigned int ins_0xe8(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_b = inst_eor (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_b = inst_eor (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xf8(void) {
+unsigned int ins_0xf8(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_b = inst_eor (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_b = inst_eor (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* adca */
-unsigned int ins_0x89(void) {
-		reg_a = inst_adc (reg_a, pc_read8 ());
-		return 2;
+unsigned int ins_0x89(e6809_t *cpu) {
+		cpu->reg_a = inst_adc (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0x99(void) {
+unsigned int ins_0x99(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_a = inst_adc (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_a = inst_adc (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xa9(void) {
+unsigned int ins_0xa9(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_a = inst_adc (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_a = inst_adc (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xb9(void) {
+unsigned int ins_0xb9(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_a = inst_adc (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_a = inst_adc (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* adcb */
-unsigned int ins_0xc9(void) {
-		reg_b = inst_adc (reg_b, pc_read8 ());
-		return 2;
+unsigned int ins_0xc9(e6809_t *cpu) {
+		cpu->reg_b = inst_adc (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0xd9(void) {
+unsigned int ins_0xd9(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_b = inst_adc (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_b = inst_adc (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xe9(void) {
+unsigned int ins_0xe9(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_b = inst_adc (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_b = inst_adc (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xf9(void) {
+unsigned int ins_0xf9(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_b = inst_adc (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_b = inst_adc (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* ora */
-unsigned int ins_0x8a(void) {
-		reg_a = inst_or (reg_a, pc_read8 ());
-		return 2;
+unsigned int ins_0x8a(e6809_t *cpu) {
+		cpu->reg_a = inst_or (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0x9a(void) {
+unsigned int ins_0x9a(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_a = inst_or (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_a = inst_or (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xaa(void) {
+unsigned int ins_0xaa(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_a = inst_or (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_a = inst_or (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xba(void) {
+unsigned int ins_0xba(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_a = inst_or (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_a = inst_or (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* orb */
-unsigned int ins_0xca(void) {
-		reg_b = inst_or (reg_b, pc_read8 ());
-		return 2;
+unsigned int ins_0xca(e6809_t *cpu) {
+		cpu->reg_b = inst_or (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0xda(void) {
+unsigned int ins_0xda(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_b = inst_or (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_b = inst_or (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xea(void) {
+unsigned int ins_0xea(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_b = inst_or (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_b = inst_or (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xfa(void) {
+unsigned int ins_0xfa(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_b = inst_or (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_b = inst_or (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* adda */
-unsigned int ins_0x8b(void) {
-		reg_a = inst_add8 (reg_a, pc_read8 ());
-		return 2;
+unsigned int ins_0x8b(e6809_t *cpu) {
+		cpu->reg_a = inst_add8 (cpu, cpu->reg_a, pc_read8 (cpu));
+		return 0;
 }
 
-unsigned int ins_0x9b(void) {
+unsigned int ins_0x9b(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_a = inst_add8 (reg_a, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_a = inst_add8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 
 // here
-unsigned int ins_0xab(void) {
+unsigned int ins_0xab(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_a = inst_add8 (reg_a, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_a = inst_add8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xbb(void) {
+unsigned int ins_0xbb(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_a = inst_add8 (reg_a, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_a = inst_add8 (cpu, cpu->reg_a, read8 (cpu, ea));
+		return 0;}
 		
 	/* addb */
-unsigned int ins_0xcb(void) {
-		reg_b = inst_add8 (reg_b, pc_read8 ());
-		return 2;}
+unsigned int ins_0xcb(e6809_t *cpu) {
+		cpu->reg_b = inst_add8 (cpu, cpu->reg_b, pc_read8 (cpu));
+		return 0;}
 		
-unsigned int ins_0xdb(void) {
+unsigned int ins_0xdb(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_b = inst_add8 (reg_b, read8 (ea));
-		return 4;}
+		ea = ea_direct (cpu);
+		cpu->reg_b = inst_add8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xeb(void) {
+unsigned int ins_0xeb(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_b = inst_add8 (reg_b, read8 (ea));
-		return cycles + 4;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_b = inst_add8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xfb(void) {
+unsigned int ins_0xfb(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_b = inst_add8 (reg_b, read8 (ea));
-		return 5;}
+		ea = ea_extended (cpu);
+		cpu->reg_b = inst_add8 (cpu, cpu->reg_b, read8 (cpu, ea));
+		return 0;}
 		
 	/* subd */
-unsigned int ins_0x83(void) {
-		set_reg_d (inst_sub16 (get_reg_d (), pc_read16 ()));
-		return 4;}
+unsigned int ins_0x83(e6809_t *cpu) {
+		set_reg_d (cpu, inst_sub16 (cpu, get_reg_d (cpu), pc_read16 (cpu)));
+		return 0;}
 		
-unsigned int ins_0x93(void) {
+unsigned int ins_0x93(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		set_reg_d (inst_sub16 (get_reg_d (), read16 (ea)));
-		return 6;}
+		ea = ea_direct (cpu);
+		set_reg_d (cpu, inst_sub16 (cpu, get_reg_d (cpu), read16 (cpu, ea)));
+		return 0;}
 		
-unsigned int ins_0xa3(void) {
+unsigned int ins_0xa3(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		set_reg_d (inst_sub16 (get_reg_d (), read16 (ea)));
-		return cycles + 6;}
+		ea = ea_indexed (cpu, &cycles);
+		set_reg_d (cpu, inst_sub16 (cpu, get_reg_d (cpu), read16 (cpu, ea)));
+		return cycles;}
 		
-unsigned int ins_0xb3(void) {
+unsigned int ins_0xb3(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		set_reg_d (inst_sub16 (get_reg_d (), read16 (ea)));
-		return 7;}
+		ea = ea_extended (cpu);
+		set_reg_d (cpu, inst_sub16 (cpu, get_reg_d (cpu), read16 (cpu, ea)));
+		return 0;}
 		
 	/* cmpx */
-unsigned int ins_0x8c(void) {
-		inst_sub16 (reg_x, pc_read16 ());
-		return 4;}
+unsigned int ins_0x8c(e6809_t *cpu) {
+		inst_sub16 (cpu, cpu->reg_x, pc_read16 (cpu));
+		return 0;}
 		
-unsigned int ins_0x9c(void) {
+unsigned int ins_0x9c(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		inst_sub16 (reg_x, read16 (ea));
-		return 6;}
+		ea = ea_direct (cpu);
+		inst_sub16 (cpu, cpu->reg_x, read16 (cpu, ea));
+		return 0;}
 		
-unsigned int ins_0xac(void) {
+unsigned int ins_0xac(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		inst_sub16 (reg_x, read16 (ea));
-		return cycles + 6;}
+		ea = ea_indexed (cpu, &cycles);
+		inst_sub16 (cpu, cpu->reg_x, read16 (cpu, ea));
+		return cycles;}
 		
-unsigned int ins_0xbc(void) {
+unsigned int ins_0xbc(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		inst_sub16 (reg_x, read16 (ea));
-		return 7;}
+		ea = ea_extended (cpu);
+		inst_sub16 (cpu, cpu->reg_x, read16 (cpu, ea));
+		return 0;}
 		
 	/* ldx */
-unsigned int ins_0x8e(void) {
-		reg_x = pc_read16 ();
-		inst_tst16 (reg_x);
-		return 3;}
+unsigned int ins_0x8e(e6809_t *cpu) {
+		cpu->reg_x = pc_read16 (cpu);
+		inst_tst16 (cpu, cpu->reg_x);
+		return 0;}
 		
-unsigned int ins_0x9e(void) {
+unsigned int ins_0x9e(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_x = read16 (ea);
-		inst_tst16 (reg_x);
-		return 5;}
+		ea = ea_direct (cpu);
+		cpu->reg_x = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_x);
+		return 0;}
 		
-unsigned int ins_0xae(void) {
+unsigned int ins_0xae(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_x = read16 (ea);
-		inst_tst16 (reg_x);
-		return cycles + 5;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_x = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_x);
+		return cycles;}
 		
-unsigned int ins_0xbe(void) {
+unsigned int ins_0xbe(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_x = read16 (ea);
-		inst_tst16 (reg_x);
-		return 6;}
+		ea = ea_extended (cpu);
+		cpu->reg_x = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_x);
+		return 0;}
 		
 	/* ldu */
-unsigned int ins_0xce(void) {
-		reg_u = pc_read16 ();
-		inst_tst16 (reg_u);
-		return 3;}
+unsigned int ins_0xce(e6809_t *cpu) {
+		cpu->reg_u = pc_read16 (cpu);
+		inst_tst16 (cpu, cpu->reg_u);
+		return 0;}
 		
-unsigned int ins_0xde(void) {
+unsigned int ins_0xde(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		reg_u = read16 (ea);
-		inst_tst16 (reg_u);
-		return 5;}
+		ea = ea_direct (cpu);
+		cpu->reg_u = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_u);
+		return 0;}
 		
-unsigned int ins_0xee(void) {
+unsigned int ins_0xee(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		reg_u = read16 (ea);
-		inst_tst16 (reg_u);
-		return cycles + 5;}
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_u = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_u);
+		return cycles;}
 		
-unsigned int ins_0xfe(void) {
+unsigned int ins_0xfe(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		reg_u = read16 (ea);
-		inst_tst16 (reg_u);
-		return 6;}
+		ea = ea_extended (cpu);
+		cpu->reg_u = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_u);
+		return 0;}
 		
 	/* stx */
-unsigned int ins_0x9f(void) {
+unsigned int ins_0x9f(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		write16 (ea, reg_x);
-		inst_tst16 (reg_x);
-		return 5;}
+		ea = ea_direct (cpu);
+		write16 (cpu, ea, cpu->reg_x);
+		inst_tst16 (cpu, cpu->reg_x);
+		return 0;}
 		
-unsigned int ins_0xaf(void) {
+unsigned int ins_0xaf(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		write16 (ea, reg_x);
-		inst_tst16 (reg_x);
-		return cycles + 5;}
+		ea = ea_indexed (cpu, &cycles);
+		write16 (cpu, ea, cpu->reg_x);
+		inst_tst16 (cpu, cpu->reg_x);
+		return cycles;}
 		
-unsigned int ins_0xbf(void) {
+unsigned int ins_0xbf(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		write16 (ea, reg_x);
-		inst_tst16 (reg_x);
-		return 6;}
+		ea = ea_extended (cpu);
+		write16 (cpu, ea, cpu->reg_x);
+		inst_tst16 (cpu, cpu->reg_x);
+		return 0;}
 		
 	/* stu */
-unsigned int ins_0xdf(void) {
+unsigned int ins_0xdf(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		write16 (ea, reg_u);
-		inst_tst16 (reg_u);
-		return 5;}
+		ea = ea_direct (cpu);
+		write16 (cpu, ea, cpu->reg_u);
+		inst_tst16 (cpu, cpu->reg_u);
+		return 0;}
 		
-unsigned int ins_0xef(void) {
+unsigned int ins_0xef(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		write16 (ea, reg_u);
-		inst_tst16 (reg_u);
-		return cycles + 5;}
+		ea = ea_indexed (cpu, &cycles);
+		write16 (cpu, ea, cpu->reg_u);
+		inst_tst16 (cpu, cpu->reg_u);
+		return cycles;}
 		
-unsigned int ins_0xff(void) {
+unsigned int ins_0xff(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		write16 (ea, reg_u);
-		inst_tst16 (reg_u);
-		return 6;}
+		ea = ea_extended (cpu);
+		write16 (cpu, ea, cpu->reg_u);
+		inst_tst16 (cpu, cpu->reg_u);
+		return 0;}
 		
 	/* addd */
-unsigned int ins_0xc3(void) {
-		set_reg_d (inst_add16 (get_reg_d (), pc_read16 ()));
-		return 4;}
+unsigned int ins_0xc3(e6809_t *cpu) {
+		set_reg_d (cpu, inst_add16 (cpu, get_reg_d (cpu), pc_read16 (cpu)));
+		return 0;}
 		
-unsigned int ins_0xd3(void) {
+unsigned int ins_0xd3(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		set_reg_d (inst_add16 (get_reg_d (), read16 (ea)));
-		return 6;}
+		ea = ea_direct (cpu);
+		set_reg_d (cpu, inst_add16 (cpu, get_reg_d (cpu), read16 (cpu, ea)));
+		return 0;}
 		
-unsigned int ins_0xe3(void) {
+unsigned int ins_0xe3(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		set_reg_d (inst_add16 (get_reg_d (), read16 (ea)));
-		return cycles + 6;}
+		ea = ea_indexed (cpu, &cycles);
+		set_reg_d (cpu, inst_add16 (cpu, get_reg_d (cpu), read16 (cpu, ea)));
+		return cycles;}
 		
-unsigned int ins_0xf3(void) {
+unsigned int ins_0xf3(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		set_reg_d (inst_add16 (get_reg_d (), read16 (ea)));
-		return 7;}
+		ea = ea_extended (cpu);
+		set_reg_d (cpu, inst_add16 (cpu, get_reg_d (cpu), read16 (cpu, ea)));
+		return 0;}
 		
 	/* ldd */
-unsigned int ins_0xcc(void) {
-		set_reg_d (pc_read16 ());
-		inst_tst16 (get_reg_d ());
-		return 3;}
+unsigned int ins_0xcc(e6809_t *cpu) {
+		set_reg_d (cpu, pc_read16 (cpu));
+		inst_tst16 (cpu, get_reg_d (cpu));
+		return 0;}
 		
-unsigned int ins_0xdc(void) {
+unsigned int ins_0xdc(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		set_reg_d (read16 (ea));
-		inst_tst16 (get_reg_d ());
-		return 5;}
+		ea = ea_direct (cpu);
+		set_reg_d (cpu, read16 (cpu, ea));
+		inst_tst16 (cpu, get_reg_d (cpu));
+		return 0;}
 		
-unsigned int ins_0xec(void) {
+unsigned int ins_0xec(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		set_reg_d (read16 (ea));
-		inst_tst16 (get_reg_d ());
-		return cycles + 5;}
+		ea = ea_indexed (cpu, &cycles);
+		set_reg_d (cpu, read16 (cpu, ea));
+		inst_tst16 (cpu, get_reg_d (cpu));
+		return cycles;}
 		
-unsigned int ins_0xfc(void) {
+unsigned int ins_0xfc(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		set_reg_d (read16 (ea));
-		inst_tst16 (get_reg_d ());
-		return 6;}
+		ea = ea_extended (cpu);
+		set_reg_d (cpu, read16 (cpu, ea));
+		inst_tst16 (cpu, get_reg_d (cpu));
+		return 0;}
 		
 	/* std */
-unsigned int ins_0xdd(void) {
+unsigned int ins_0xdd(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		write16 (ea, get_reg_d ());
-		inst_tst16 (get_reg_d ());
-		return 5;}
+		ea = ea_direct (cpu);
+		write16 (cpu, ea, get_reg_d (cpu));
+		inst_tst16 (cpu, get_reg_d (cpu));
+		return 0;}
 		
-unsigned int ins_0xed(void) {
+unsigned int ins_0xed(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		write16 (ea, get_reg_d ());
-		inst_tst16 (get_reg_d ());
-		return cycles + 5;}
+		ea = ea_indexed (cpu, &cycles);
+		write16 (cpu, ea, get_reg_d (cpu));
+		inst_tst16 (cpu, get_reg_d (cpu));
+		return cycles;}
 		
-unsigned int ins_0xfd(void) {
+unsigned int ins_0xfd(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		write16 (ea, get_reg_d ());
-		inst_tst16 (get_reg_d ());
-		return 6;}
+		ea = ea_extended (cpu);
+		write16 (cpu, ea, get_reg_d (cpu));
+		inst_tst16 (cpu, get_reg_d (cpu));
+		return 0;}
 		
 	/* nop */
-unsigned int ins_0x12(void) {
-		return 2;}
+unsigned int ins_0x12(e6809_t *cpu) {
+		return 0;}
 		
 	/* mul */
-unsigned int ins_0x3d(void) {
+unsigned int ins_0x3d(e6809_t *cpu) {
 	unsigned short  r;
-		r = (reg_a & 0xff) * (reg_b & 0xff);
-		set_reg_d (r);
+		r = (cpu->reg_a & 0xff) * (cpu->reg_b & 0xff);
+		set_reg_d (cpu, r);
 
-		set_cc (FLAG_Z, test_z16 (r));
-		set_cc (FLAG_C, (r >> 7) & 1);
+		set_cc (cpu, FLAG_Z, test_z16 (r));
+		set_cc (cpu, FLAG_C, (r >> 7) & 1);
 
-		return 11;}
+		return 0;}
 		
 	/* bra */
-unsigned int ins_0x20(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (0, op, &cycles);
-		inst_bra8 (0, 0x20, &cycles);
-		return cycles;
+unsigned int ins_0x20(e6809_t *cpu) {
+//		inst_bra8 (cpu, 0, op);
+		inst_bra8 (cpu, 0, 0x20);
+		return 0;
 }		
 
 	/* brn */
-unsigned int ins_0x21(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (0, op, &cycles);
-		inst_bra8 (0, 0x21, &cycles);
-		return cycles;
+unsigned int ins_0x21(e6809_t *cpu) {
+//		inst_bra8 (cpu, 0, op);
+		inst_bra8 (cpu, 0, 0x21);
+		return 0;
 }		
 	/* bhi */
-unsigned int ins_0x22(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_C) | get_cc (FLAG_Z), op, &cycles);
-		inst_bra8 (get_cc (FLAG_C) | get_cc (FLAG_Z), 0x22, &cycles);
-		return cycles;
+unsigned int ins_0x22(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_C) | get_cc (cpu, FLAG_Z), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_C) | get_cc (cpu, FLAG_Z), 0x22);
+		return 0;
 }		
 	/* bls */
-unsigned int ins_0x23(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_C) | get_cc (FLAG_Z), op, &cycles);
-		inst_bra8 (get_cc (FLAG_C) | get_cc (FLAG_Z), 0x23, &cycles);
-		return cycles;
+unsigned int ins_0x23(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_C) | get_cc (cpu, FLAG_Z), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_C) | get_cc (cpu, FLAG_Z), 0x23);
+		return 0;
 }		
 	/* bhs/bcc */
-unsigned int ins_0x24(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_C), op, &cycles);
-		inst_bra8 (get_cc (FLAG_C), 0x24, &cycles);
-		return cycles;
+unsigned int ins_0x24(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_C), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_C), 0x24);
+		return 0;
 }		
 	/* blo/bcs */
-unsigned int ins_0x25(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_C), op, &cycles);
-		inst_bra8 (get_cc (FLAG_C), 0x25, &cycles);
-		return cycles;
+unsigned int ins_0x25(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_C), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_C), 0x25);
+		return 0;
 }		
 	/* bne */
-unsigned int ins_0x26(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_Z), op, &cycles);
-		inst_bra8 (get_cc (FLAG_Z), 0x26, &cycles);
-		return cycles;
+unsigned int ins_0x26(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_Z), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_Z), 0x26);
+		return 0;
 }		
 	/* beq */
-unsigned int ins_0x27(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_Z), op, &cycles);
-		inst_bra8 (get_cc (FLAG_Z), 0x27, &cycles);
-		return cycles;
+unsigned int ins_0x27(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_Z), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_Z), 0x27);
+		return 0;
 }		
 	/* bvc */
-unsigned int ins_0x28(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_V), op, &cycles);
-		inst_bra8 (get_cc (FLAG_V), 0x28, &cycles);
-		return cycles;
+unsigned int ins_0x28(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_V), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_V), 0x28);
+		return 0;
 }		
 	/* bvs */
-unsigned int ins_0x29(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_V), op, &cycles);
-		inst_bra8 (get_cc (FLAG_V), 0x29, &cycles);
-		return cycles;
+unsigned int ins_0x29(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_V), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_V), 0x29);
+		return 0;
 }		
 	/* bpl */
-unsigned int ins_0x2a(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_N), op, &cycles);
-		inst_bra8 (get_cc (FLAG_N), 0x2a, &cycles);
-		return cycles;
+unsigned int ins_0x2a(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_N), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_N), 0x2a);
+		return 0;
 }		
 	/* bmi */
-unsigned int ins_0x2b(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_N), op, &cycles);
-		inst_bra8 (get_cc (FLAG_N), 0x2b, &cycles);
-		return cycles;
+unsigned int ins_0x2b(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_N), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_N), 0x2b);
+		return 0;
 }		
 	/* bge */
-unsigned int ins_0x2c(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_N) ^ get_cc (FLAG_V), op, &cycles);
-		inst_bra8 (get_cc (FLAG_N) ^ get_cc (FLAG_V), 0x2c, &cycles);
-		return cycles;
+unsigned int ins_0x2c(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V), 0x2c);
+		return 0;
 }		
 	/* blt */
-unsigned int ins_0x2d(void) {
-		unsigned short  cycles = 0;
-
-//		inst_bra8 (get_cc (FLAG_N) ^ get_cc (FLAG_V), op, &cycles);
-		inst_bra8 (get_cc (FLAG_N) ^ get_cc (FLAG_V), 0x2d, &cycles);
-		return cycles;
+unsigned int ins_0x2d(e6809_t *cpu) {
+//		inst_bra8 (cpu, get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V), op);
+		inst_bra8 (cpu, get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V), 0x2d);
+		return 0;
 }		
 	/* bgt */
-unsigned int ins_0x2e(void) {
-		unsigned short  cycles = 0;
-
-		inst_bra8 (get_cc (FLAG_Z) |
-				   (get_cc (FLAG_N) ^ get_cc (FLAG_V)), 0x2e, &cycles);
-//				   (get_cc (FLAG_N) ^ get_cc (FLAG_V)), op, &cycles);
-		return cycles;
+unsigned int ins_0x2e(e6809_t *cpu) {
+		inst_bra8 (cpu, get_cc (cpu, FLAG_Z) |
+				   (get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V)), 0x2e);
+//				   (get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V)), op);
+		return 0;
 }		
 	/* ble */
-unsigned int ins_0x2f(void) {
-		unsigned short  cycles = 0;
-
-		inst_bra8 (get_cc (FLAG_Z) |
-				   (get_cc (FLAG_N) ^ get_cc (FLAG_V)), 0x2f, &cycles);
-//				   (get_cc (FLAG_N) ^ get_cc (FLAG_V)), op, &cycles);
-		return cycles;
+unsigned int ins_0x2f(e6809_t *cpu) {
+		inst_bra8 (cpu, get_cc (cpu, FLAG_Z) |
+				   (get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V)), 0x2f);
+//				   (get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V)), op);
+		return 0;
 }		
 	/* lbra */
-unsigned int ins_0x16(void) {
+unsigned int ins_0x16(e6809_t *cpu) {
 	unsigned short  r;
-		r = pc_read16 ();
-		reg_pc += r;
-		return 5;}
+		r = pc_read16 (cpu);
+		cpu->reg_pc += r;
+		return 0;}
 		
 	/* lbsr */
-unsigned int ins_0x17(void) {
+unsigned int ins_0x17(e6809_t *cpu) {
 	unsigned short  r;
-		r = pc_read16 ();
-		push16 (&reg_s, reg_pc);
-		reg_pc += r;
-		return 9;}
+		r = pc_read16 (cpu);
+		push16 (cpu, &cpu->reg_s, cpu->reg_pc);
+		cpu->reg_pc += r;
+		return 0;}
 		
 	/* bsr */
-unsigned int ins_0x8d(void) {
+unsigned int ins_0x8d(e6809_t *cpu) {
 	unsigned short  r;
-		r = pc_read8 ();
-		push16 (&reg_s, reg_pc);
-		reg_pc += sign_extend (r);
-		return 7;}
+		r = pc_read8 (cpu);
+		push16 (cpu, &cpu->reg_s, cpu->reg_pc);
+		cpu->reg_pc += sign_extend (r);
+		return 0;}
 		
 	/* jsr */
-unsigned int ins_0x9d(void) {
+unsigned int ins_0x9d(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_direct ();
-		push16 (&reg_s, reg_pc);
-		reg_pc = ea;
-		return 7;}
+		ea = ea_direct (cpu);
+		push16 (cpu, &cpu->reg_s, cpu->reg_pc);
+		cpu->reg_pc = ea;
+		return 0;}
 		
-unsigned int ins_0xad(void) {
+unsigned int ins_0xad(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
-		ea = ea_indexed (&cycles);
-		push16 (&reg_s, reg_pc);
-		reg_pc = ea;
-		return cycles + 7;}
+		ea = ea_indexed (cpu, &cycles);
+		push16 (cpu, &cpu->reg_s, cpu->reg_pc);
+		cpu->reg_pc = ea;
+		return cycles;}
 		
-unsigned int ins_0xbd(void) {
+unsigned int ins_0xbd(e6809_t *cpu) {
 	unsigned short  ea;
-		ea = ea_extended ();
-		push16 (&reg_s, reg_pc);
-		reg_pc = ea;
-		return 8;}
+		ea = ea_extended (cpu);
+		push16 (cpu, &cpu->reg_s, cpu->reg_pc);
+		cpu->reg_pc = ea;
+		return 0;}
 		
 	/* leax */
-unsigned int ins_0x30(void) {
+unsigned int ins_0x30(e6809_t *cpu) {
 		unsigned short  cycles = 0;
-		reg_x = ea_indexed (&cycles);
-		set_cc (FLAG_Z, test_z16 (reg_x));
-		return cycles + 4;}
+		cpu->reg_x = ea_indexed (cpu, &cycles);
+		set_cc (cpu, FLAG_Z, test_z16 (cpu->reg_x));
+		return cycles;}
 		
 	/* leay */
-unsigned int ins_0x31(void) {
+unsigned int ins_0x31(e6809_t *cpu) {
 		unsigned short  cycles = 0;
-		reg_y = ea_indexed (&cycles);
-		set_cc (FLAG_Z, test_z16 (reg_y));
-		return cycles + 4;}
+		cpu->reg_y = ea_indexed (cpu, &cycles);
+		set_cc (cpu, FLAG_Z, test_z16 (cpu->reg_y));
+		return cycles;}
 		
 	/* leas */
-unsigned int ins_0x32(void) {
+unsigned int ins_0x32(e6809_t *cpu) {
 		unsigned short  cycles = 0;
-		reg_s = ea_indexed (&cycles);
-		return cycles + 4;}
+		cpu->reg_s = ea_indexed (cpu, &cycles);
+		return cycles;}
 		
 	/* leau */
-unsigned int ins_0x33(void) {
+unsigned int ins_0x33(e6809_t *cpu) {
 		unsigned short  cycles = 0;
-		reg_u = ea_indexed (&cycles);
-		return cycles + 4;}
+		cpu->reg_u = ea_indexed (cpu, &cycles);
+		return cycles;}
 		
 	/* pshs */
-unsigned int ins_0x34(void) {
+unsigned int ins_0x34(e6809_t *cpu) {
 		unsigned short  cycles = 0;
 
-		inst_psh (pc_read8 (), &reg_s, reg_u, &cycles);
-		return cycles + 5;}
+		inst_psh (cpu, pc_read8 (cpu), &cpu->reg_s, cpu->reg_u, &cycles);
+		return cycles;}
 		
 	/* puls */
-unsigned int ins_0x35(void) {
+unsigned int ins_0x35(e6809_t *cpu) {
 		unsigned short  cycles = 0;
 
-		inst_pul (pc_read8 (), &reg_s, &reg_u, &cycles);
-		return cycles + 5;}
+		inst_pul (cpu, pc_read8 (cpu), &cpu->reg_s, &cpu->reg_u, &cycles);
+		return cycles;}
 		
 	/* pshu */
-unsigned int ins_0x36(void) {
+unsigned int ins_0x36(e6809_t *cpu) {
 		unsigned short  cycles = 0;
 
-		inst_psh (pc_read8 (), &reg_u, reg_s, &cycles);
-		return cycles + 5;}
+		inst_psh (cpu, pc_read8 (cpu), &cpu->reg_u, cpu->reg_s, &cycles);
+		return cycles;}
 		
 	/* pulu */
-unsigned int ins_0x37(void) {
+unsigned int ins_0x37(e6809_t *cpu) {
 		unsigned short  cycles = 0;
 
-		inst_pul (pc_read8 (), &reg_u, &reg_s, &cycles);
-		return cycles + 5;}
+		inst_pul (cpu, pc_read8 (cpu), &cpu->reg_u, &cpu->reg_s, &cycles);
+		return cycles;}
 		
 	/* rts */
-unsigned int ins_0x39(void) {
-		reg_pc = pull16 (&reg_s);
-		return 5;}
+unsigned int ins_0x39(e6809_t *cpu) {
+		cpu->reg_pc = pull16 (cpu, &cpu->reg_s);
+		return 0;}
 		
 	/* abx */
-unsigned int ins_0x3a(void) {
-		reg_x += reg_b & 0xff;
-		return 3;}
+unsigned int ins_0x3a(e6809_t *cpu) {
+		cpu->reg_x += cpu->reg_b & 0xff;
+		return 0;}
 		
 	/* orcc */
-unsigned int ins_0x1a(void) {
-		reg_cc |= pc_read8 ();
-		return 3;}
+unsigned int ins_0x1a(e6809_t *cpu) {
+		set_reg_cc (cpu, get_reg_cc (cpu) | pc_read8 (cpu));
+		return 0;}
 		
 	/* andcc */
-unsigned int ins_0x1c(void) {
-		reg_cc &= pc_read8 ();
-		return 3;}
+unsigned int ins_0x1c(e6809_t *cpu) {
+		set_reg_cc (cpu, get_reg_cc (cpu) & pc_read8 (cpu));
+		return 0;}
 		
 	/* sex */
-unsigned int ins_0x1d(void) {
-		set_reg_d (sign_extend (reg_b));
-		set_cc (FLAG_N, test_n (reg_a));
-		set_cc (FLAG_Z, test_z16 (get_reg_d ()));
-		return 2;}
+unsigned int ins_0x1d(e6809_t *cpu) {
+		set_reg_d (cpu, sign_extend (cpu->reg_b));
+		set_cc (cpu, FLAG_N, test_n (cpu->reg_a));
+		set_cc (cpu, FLAG_Z, test_z16 (get_reg_d (cpu)));
+		return 0;}
 		
 	/* exg */
-unsigned int ins_0x1e(void) {
-		inst_exg ();
-		return 8;}
+unsigned int ins_0x1e(e6809_t *cpu) {
+		inst_exg (cpu);
+		return 0;}
 		
 	/* tfr */
-unsigned int ins_0x1f(void) {
-		inst_tfr ();
-		return 6;}
+unsigned int ins_0x1f(e6809_t *cpu) {
+		inst_tfr (cpu);
+		return 0;}
 		
 	/* rti */
-unsigned int ins_0x3b(void) {
+unsigned int ins_0x3b(e6809_t *cpu) {
 		unsigned short  cycles = 0;
 
-		if (get_cc (FLAG_E)) {
-			inst_pul (0xff, &reg_s, &reg_u, &cycles);
+		if (get_cc (cpu, FLAG_E)) {
+			inst_pul (cpu, 0xff, &cpu->reg_s, &cpu->reg_u, &cycles);
 		} else {
-			inst_pul (0x81, &reg_s, &reg_u, &cycles);
+			inst_pul (cpu, 0x81, &cpu->reg_s, &cpu->reg_u, &cycles);
 		}
 
-		return cycles + 3;}
+		return cycles;}
 		
 	/* swi */
-unsigned int ins_0x3f(void) {
+unsigned int ins_0x3f(e6809_t *cpu) {
 		unsigned short  cycles = 0;
 
-		set_cc (FLAG_E, 1);
-		inst_psh (0xff, &reg_s, reg_u, &cycles);
-		set_cc (FLAG_I, 1);
-		set_cc (FLAG_F, 1);
-        reg_pc = read16 (0xfffa);
-        return cycles + 7;}
+		set_cc (cpu, FLAG_E, 1);
+		inst_psh (cpu, 0xff, &cpu->reg_s, cpu->reg_u, &cycles);
+		set_cc (cpu, FLAG_I, 1);
+		set_cc (cpu, FLAG_F, 1);
+        cpu->reg_pc = read16 (cpu, 0xfffa);
+        return cycles;}
 		
 	/* sync */
-unsigned int ins_0x13(void) {
-		irq_status = IRQ_SYNC;
-		return 2;}
+unsigned int ins_0x13(e6809_t *cpu) {
+		cpu->irq_status = IRQ_SYNC;
+		return 0;}
 		
 	/* daa */
-unsigned int ins_0x19(void) {
+unsigned int ins_0x19(e6809_t *cpu) {
 	unsigned short  i0, i1;
-		i0 = reg_a;
+		i0 = cpu->reg_a;
 		i1 = 0;
 
-		if ((reg_a & 0x0f) > 0x09 || get_cc (FLAG_H) == 1) {
+		if ((cpu->reg_a & 0x0f) > 0x09 || get_cc (cpu, FLAG_H) == 1) {
 			i1 |= 0x06;
 		}
 
-		if ((reg_a & 0xf0) > 0x80 && (reg_a & 0x0f) > 0x09) {
+		if ((cpu->reg_a & 0xf0) > 0x80 && (cpu->reg_a & 0x0f) > 0x09) {
 			i1 |= 0x60;
 		}
 
-		if ((reg_a & 0xf0) > 0x90 || get_cc (FLAG_C) == 1) {
+		if ((cpu->reg_a & 0xf0) > 0x90 || get_cc (cpu, FLAG_C) == 1) {
 			i1 |= 0x60;
 		}
 
-		reg_a = i0 + i1;
+		cpu->reg_a = i0 + i1;
 
-		set_cc (FLAG_N, test_n (reg_a));
-		set_cc (FLAG_Z, test_z8 (reg_a));
-		set_cc (FLAG_V, 0);
-		set_cc (FLAG_C, test_c (i0, i1, reg_a, 0));
-		return 2;}
+		set_cc (cpu, FLAG_N, test_n (cpu->reg_a));
+		set_cc (cpu, FLAG_Z, test_z8 (cpu->reg_a));
+		set_cc (cpu, FLAG_V, 0);
+		set_cc (cpu, FLAG_C, test_c (i0, i1, cpu->reg_a, 0));
+		return 0;}
 		
 	/* cwai */
-unsigned int ins_0x3c(void) {
+unsigned int ins_0x3c(e6809_t *cpu) {
 		unsigned short  cycles = 0;
 
-		reg_cc &= pc_read8 ();
-		set_cc (FLAG_E, 1);
-		inst_psh (0xff, &reg_s, reg_u, &cycles);
-		irq_status = IRQ_CWAI;
-		return cycles + 4;}
+		set_reg_cc (cpu, get_reg_cc (cpu) & pc_read8 (cpu));
+		set_cc (cpu, FLAG_E, 1);
+		inst_psh (cpu, 0xff, &cpu->reg_s, cpu->reg_u, &cycles);
+		cpu->irq_status = IRQ_CWAI;
+		return cycles;}
 		
 
 	/* page 1 instructions */
 
-unsigned int ins_0x10(void) {
+	/* lbra */
+unsigned int ins_0x10_0x20(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, 0, 0x20, &cycles);
+		return cycles;
+}
 
-	unsigned short  op;
+	/* lbrn */
+unsigned int ins_0x10_0x21(e6809_t *cpu) {
 	unsigned short  cycles = 0;
-	unsigned short  ea;
+		inst_bra16 (cpu, 0, 0x21, &cycles);
+		return cycles;
+}
 
-		op = pc_read8 ();
+	/* lbhi */
+unsigned int ins_0x10_0x22(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_C) | get_cc (cpu, FLAG_Z), 0x22, &cycles);
+		return cycles;
+}
 
-		switch (op) {
-		/* lbra */
-		case 0x20:
-		/* lbrn */
-		case 0x21:
-			inst_bra16 (0, op, &cycles);
-			break;
-		/* lbhi */
-		case 0x22:
-		/* lbls */
-		case 0x23:
-			inst_bra16 (get_cc (FLAG_C) | get_cc (FLAG_Z), op, &cycles);
-			break;
-		/* lbhs/lbcc */
-		case 0x24:
-		/* lblo/lbcs */
-		case 0x25:
-			inst_bra16 (get_cc (FLAG_C), op, &cycles);
-			break;
-		/* lbne */
-		case 0x26:
-		/* lbeq */
-		case 0x27:
-			inst_bra16 (get_cc (FLAG_Z), op, &cycles);
-			break;
-		/* lbvc */
-		case 0x28:
-		/* lbvs */
-		case 0x29:
-			inst_bra16 (get_cc (FLAG_V), op, &cycles);
-			break;
-		/* lbpl */
-		case 0x2a:
-		/* lbmi */
-		case 0x2b:
-			inst_bra16 (get_cc (FLAG_N), op, &cycles);
-			break;
-		/* lbge */
-		case 0x2c:
-		/* lblt */
-		case 0x2d:
-			inst_bra16 (get_cc (FLAG_N) ^ get_cc (FLAG_V), op, &cycles);
-			break;
-		/* lbgt */
-		case 0x2e:
-		/* lble */
-		case 0x2f:
-			inst_bra16 (get_cc (FLAG_Z) |
-						(get_cc (FLAG_N) ^ get_cc (FLAG_V)), op, &cycles);
-			break;
-		/* cmpd */
-		case 0x83:
-			inst_sub16 (get_reg_d (), pc_read16 ());
-			cycles += 5;
-			break;
-		case 0x93:
-			ea = ea_direct ();
-			inst_sub16 (get_reg_d (), read16 (ea));
-			cycles += 7;
-			break;
-		case 0xa3:
-			ea = ea_indexed (&cycles);
-			inst_sub16 (get_reg_d (), read16 (ea));
-			cycles += 7;
-			break;
-		case 0xb3:
-			ea = ea_extended ();
-			inst_sub16 (get_reg_d (), read16 (ea));
-			cycles += 8;
-			break;
-		/* cmpy */
-		case 0x8c:
-			inst_sub16 (reg_y, pc_read16 ());
-			cycles += 5;
-			break;
-		case 0x9c:
-			ea = ea_direct ();
-			inst_sub16 (reg_y, read16 (ea));
-			cycles += 7;
-			break;
-		case 0xac:
-			ea = ea_indexed (&cycles);
-			inst_sub16 (reg_y, read16 (ea));
-			cycles += 7;
-			break;
-		case 0xbc:
-			ea = ea_extended ();
-			inst_sub16 (reg_y, read16 (ea));
-			cycles += 8;
-			break;
-		/* ldy */
-		case 0x8e:
-			reg_y = pc_read16 ();
-			inst_tst16 (reg_y);
-			cycles += 4;
-			break;
-		case 0x9e:
-			ea = ea_direct ();
-			reg_y = read16 (ea);
-			inst_tst16 (reg_y);
-			cycles += 6;
-			break;
-		case 0xae:
-			ea = ea_indexed (&cycles);
-			reg_y = read16 (ea);
-			inst_tst16 (reg_y);
-			cycles += 6;
-			break;
-		case 0xbe:
-			ea = ea_extended ();
-			reg_y = read16 (ea);
-			inst_tst16 (reg_y);
-			cycles += 7;
-			break;
-		/* sty */
-		case 0x9f:
-			ea = ea_direct ();
-			write16 (ea, reg_y);
-			inst_tst16 (reg_y);
-			cycles += 6;
-			break;
-		case 0xaf:
-			ea = ea_indexed (&cycles);
-			write16 (ea, reg_y);
-			inst_tst16 (reg_y);
-			cycles += 6;
-			break;
-		case 0xbf:
-			ea = ea_extended ();
-			write16 (ea, reg_y);
-			inst_tst16 (reg_y);
-			cycles += 7;
-			break;
-		/* lds */
-		case 0xce:
-			reg_s = pc_read16 ();
-			inst_tst16 (reg_s);
-			cycles += 4;
-			break;
-		case 0xde:
-			ea = ea_direct ();
-			reg_s = read16 (ea);
-			inst_tst16 (reg_s);
-			cycles += 6;
-			break;
-		case 0xee:
-			ea = ea_indexed (&cycles);
-			reg_s = read16 (ea);
-			inst_tst16 (reg_s);
-			cycles += 6;
-			break;
-		case 0xfe:
-			ea = ea_extended ();
-			reg_s = read16 (ea);
-			inst_tst16 (reg_s);
-			cycles += 7;
-			break;
-		/* sts */
-		case 0xdf:
-			ea = ea_direct ();
-			write16 (ea, reg_s);
-			inst_tst16 (reg_s);
-			cycles += 6;
-			break;
-		case 0xef:
-			ea = ea_indexed (&cycles);
-			write16 (ea, reg_s);
-			inst_tst16 (reg_s);
-			cycles += 6;
-			break;
-		case 0xff:
-			ea = ea_extended ();
-			write16 (ea, reg_s);
-			inst_tst16 (reg_s);
-			cycles += 7;
-			break;
-		/* swi2 */
-		case 0x3f:
-			set_cc (FLAG_E, 1);
-			inst_psh (0xff, &reg_s, reg_u, &cycles);
-		    reg_pc = read16 (0xfff4);
-			cycles += 8;
-			break;
-		default:
-			printf ("unknown page-1 op code: %.2x\n", op);
-			break;
-		}
+	/* lbls */
+unsigned int ins_0x10_0x23(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_C) | get_cc (cpu, FLAG_Z), 0x23, &cycles);
+		return cycles;
+}
+
+	/* lbhs/lbcc */
+unsigned int ins_0x10_0x24(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_C), 0x24, &cycles);
 		return cycles;
 }
 
+	/* lblo/lbcs */
+unsigned int ins_0x10_0x25(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_C), 0x25, &cycles);
+		return cycles;
+}
 
-	/* page 2 instructions */
+	/* lbne */
+unsigned int ins_0x10_0x26(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_Z), 0x26, &cycles);
+		return cycles;
+}
+
+	/* lbeq */
+unsigned int ins_0x10_0x27(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_Z), 0x27, &cycles);
+		return cycles;
+}
+
+	/* lbvc */
+unsigned int ins_0x10_0x28(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_V), 0x28, &cycles);
+		return cycles;
+}
+
+	/* lbvs */
+unsigned int ins_0x10_0x29(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_V), 0x29, &cycles);
+		return cycles;
+}
+
+	/* lbpl */
+unsigned int ins_0x10_0x2a(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_N), 0x2a, &cycles);
+		return cycles;
+}
+
+	/* lbmi */
+unsigned int ins_0x10_0x2b(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_N), 0x2b, &cycles);
+		return cycles;
+}
+
+	/* lbge */
+unsigned int ins_0x10_0x2c(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V), 0x2c, &cycles);
+		return cycles;
+}
+
+	/* lblt */
+unsigned int ins_0x10_0x2d(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V), 0x2d, &cycles);
+		return cycles;
+}
+
+	/* lbgt */
+unsigned int ins_0x10_0x2e(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_Z) |
+					(get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V)), 0x2e, &cycles);
+		return cycles;
+}
+
+	/* lble */
+unsigned int ins_0x10_0x2f(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		inst_bra16 (cpu, get_cc (cpu, FLAG_Z) |
+					(get_cc (cpu, FLAG_N) ^ get_cc (cpu, FLAG_V)), 0x2f, &cycles);
+		return cycles;
+}
+
+	/* cmpd */
+unsigned int ins_0x10_0x83(e6809_t *cpu) {
+		inst_sub16 (cpu, get_reg_d (cpu), pc_read16 (cpu));
+		return 0;
+}
 
-unsigned int ins_0x11(void) {
+unsigned int ins_0x10_0x93(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_direct (cpu);
+		inst_sub16 (cpu, get_reg_d (cpu), read16 (cpu, ea));
+		return 0;
+}
 
-	unsigned short  op;
+unsigned int ins_0x10_0xa3(e6809_t *cpu) {
 	unsigned short  cycles = 0;
 	unsigned short  ea;
+		ea = ea_indexed (cpu, &cycles);
+		inst_sub16 (cpu, get_reg_d (cpu), read16 (cpu, ea));
+		return cycles;
+}
 
-		op = pc_read8 ();
+unsigned int ins_0x10_0xb3(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_extended (cpu);
+		inst_sub16 (cpu, get_reg_d (cpu), read16 (cpu, ea));
+		return 0;
+}
 
-		switch (op) {
-		/* cmpu */
-		case 0x83:
-			inst_sub16 (reg_u, pc_read16 ());
-			cycles += 5;
-			break;
-		case 0x93:
-			ea = ea_direct ();
-			inst_sub16 (reg_u, read16 (ea));
-			cycles += 7;
-			break;
-		case 0xa3:
-			ea = ea_indexed (&cycles);
-			inst_sub16 (reg_u, read16 (ea));
-			cycles += 7;
-			break;
-		case 0xb3:
-			ea = ea_extended ();
-			inst_sub16 (reg_u, read16 (ea));
-			cycles += 8;
-			break;
-		/* cmps */
-		case 0x8c:
-			inst_sub16 (reg_s, pc_read16 ());
-			cycles += 5;
-			break;
-		case 0x9c:
-			ea = ea_direct ();
-			inst_sub16 (reg_s, read16 (ea));
-			cycles += 7;
-			break;
-		case 0xac:
-			ea = ea_indexed (&cycles);
-			inst_sub16 (reg_s, read16 (ea));
-			cycles += 7;
-			break;
-		case 0xbc:
-			ea = ea_extended ();
-			inst_sub16 (reg_s, read16 (ea));
-			cycles += 8;
-			break;
-		/* swi3 */
-		case 0x3f:
-			set_cc (FLAG_E, 1);
-			inst_psh (0xff, &reg_s, reg_u, &cycles);
-		    reg_pc = read16 (0xfff2);
-			cycles += 8;
-			break;
-		default:
-			printf ("unknown page-2 op code: %.2x\n", op);
-			break;
-		}
+	/* cmpy */
+unsigned int ins_0x10_0x8c(e6809_t *cpu) {
+		inst_sub16 (cpu, cpu->reg_y, pc_read16 (cpu));
+		return 0;
+}
+
+unsigned int ins_0x10_0x9c(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_direct (cpu);
+		inst_sub16 (cpu, cpu->reg_y, read16 (cpu, ea));
+		return 0;
+}
+
+unsigned int ins_0x10_0xac(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+	unsigned short  ea;
+		ea = ea_indexed (cpu, &cycles);
+		inst_sub16 (cpu, cpu->reg_y, read16 (cpu, ea));
 		return cycles;
 }
 
+unsigned int ins_0x10_0xbc(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_extended (cpu);
+		inst_sub16 (cpu, cpu->reg_y, read16 (cpu, ea));
+		return 0;
+}
 
-unsigned int ins_err(void) {
-		printf ("unknown page-0 op code\n");
+	/* ldy */
+unsigned int ins_0x10_0x8e(e6809_t *cpu) {
+		cpu->reg_y = pc_read16 (cpu);
+		inst_tst16 (cpu, cpu->reg_y);
 		return 0;
-	}
+}
 
+unsigned int ins_0x10_0x9e(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_direct (cpu);
+		cpu->reg_y = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_y);
+		return 0;
+}
 
-unsigned int (* opcodes[256])(void) = {
-		ins_0x00, ins_err , ins_err , ins_0x03, ins_0x04, ins_err , ins_0x06, ins_0x07, ins_0x08, ins_0x09, ins_0x0a, ins_err , ins_0x0c, ins_0x0d, ins_0x0e, ins_0x0f,
-		ins_0x10, ins_0x11, ins_0x12, ins_0x13, ins_err , ins_err , ins_0x16, ins_0x17, ins_err , ins_0x19, ins_0x1a, ins_err , ins_0x1c, ins_0x1d, ins_0x1e, ins_0x1f,
-		ins_0x20, ins_0x21, ins_0x22, ins_0x23, ins_0x24, ins_0x25, ins_0x26, ins_0x27, ins_0x28, ins_0x29, ins_0x2a, ins_0x2b, ins_0x2c, ins_0x2d, ins_0x2e, ins_0x2f,
-		ins_0x30, ins_0x31, ins_0x32, ins_0x33, ins_0x34, ins_0x35, ins_0x36, ins_0x37, ins_err , ins_0x39, ins_0x3a, ins_0x3b, ins_0x3c, ins_0x3d, ins_err , ins_0x3f,
-		ins_0x40, ins_err , ins_err , ins_0x43, ins_0x44, ins_err , ins_0x46, ins_0x47, ins_0x48, ins_0x49, ins_0x4a, ins_err , ins_0x4c, ins_0x4d, ins_err , ins_0x4f,
-		ins_0x50, ins_err , ins_err , ins_0x53, ins_0x54, ins_err , ins_0x56, ins_0x57, ins_0x58, ins_0x59, ins_0x5a, ins_err , ins_0x5c, ins_0x5d, ins_err , ins_0x5f,
-		ins_0x60, ins_err , ins_err , ins_0x63, ins_0x64, ins_err , ins_0x66, ins_0x67, ins_0x68, ins_0x69, ins_0x6a, ins_err , ins_0x6c, ins_0x6d, ins_0x6e, ins_0x6f,
-		ins_0x70, ins_err , ins_err , ins_0x73, ins_0x74, ins_err , ins_0x76, ins_0x77, ins_0x78, ins_0x79, ins_0x7a, ins_err , ins_0x7c, ins_0x7d, ins_0x7e, ins_0x7f,
-		ins_0x80, ins_0x81, ins_0x82, ins_0x83, ins_0x84, ins_0x85, ins_0x86, ins_err , ins_0x88, ins_0x89, ins_0x8a, ins_0x8b, ins_0x8c, ins_0x8d, ins_0x8e, ins_err ,
-		ins_0x90, ins_0x91, ins_0x92, ins_0x93, ins_0x94, ins_0x95, ins_0x96, ins_0x97, ins_0x98, ins_0x99, ins_0x9a, ins_0x9b, ins_0x9c, ins_0x9d, ins_0x9e, ins_0x9f,
-		ins_0xa0, ins_0xa1, ins_0xa2, ins_0xa3, ins_0xa4, ins_0xa5, ins_0xa6, ins_0xa7, ins_0xa8, ins_0xa9, ins_0xaa, ins_0xab, ins_0xac, ins_0xad, ins_0xae, ins_0xaf,
-		ins_0xb0, ins_0xb1, ins_0xb2, ins_0xb3, ins_0xb4, ins_0xb5, ins_0xb6, ins_0xb7, ins_0xb8, ins_0xb9, ins_0xba, ins_0xbb, ins_0xbc, ins_0xbd, ins_0xbe, ins_0xbf,
-		ins_0xc0, ins_0xc1, ins_0xc2, ins_0xc3, ins_0xc4, ins_0xc5, ins_0xc6, ins_err , ins_0xc8, ins_0xc9, ins_0xca, ins_0xcb, ins_0xcc, ins_err , ins_0xce, ins_err ,
-		ins_0xd0, ins_0xd1, ins_0xd2, ins_0xd3, ins_0xd4, ins_0xd5, ins_0xd6, ins_0xd7, ins_0xd8, ins_0xd9, ins_0xda, ins_0xdb, ins_0xdc, ins_0xdd, ins_0xde, ins_0xdf,
-		ins_0xe0, ins_0xe1, ins_0xe2, ins_0xe3, ins_0xe4, ins_0xe5, ins_0xe6, ins_0xe7, ins_0xe8, ins_0xe9, ins_0xea, ins_0xeb, ins_0xec, ins_0xed, ins_0xee, ins_0xef,
-		ins_0xf0, ins_0xf1, ins_0xf2, ins_0xf3, ins_0xf4, ins_0xf5, ins_0xf6, ins_0xf7, ins_0xf8, ins_0xf9, ins_0xfa, ins_0xfb, ins_0xfc, ins_0xfd, ins_0xfe, ins_0xff};
+unsigned int ins_0x10_0xae(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+	unsigned short  ea;
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_y = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_y);
+		return cycles;
+}
 
-/* execute a single instruction or handle interrupts and return */
+unsigned int ins_0x10_0xbe(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_extended (cpu);
+		cpu->reg_y = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_y);
+		return 0;
+}
 
-unsigned short  e6809_sstep (unsigned short  irq_i, unsigned short  irq_f)
-{
-	unsigned short  op;
+	/* sty */
+unsigned int ins_0x10_0x9f(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_direct (cpu);
+		write16 (cpu, ea, cpu->reg_y);
+		inst_tst16 (cpu, cpu->reg_y);
+		return 0;
+}
+
+unsigned int ins_0x10_0xaf(e6809_t *cpu) {
 	unsigned short  cycles = 0;
+	unsigned short  ea;
+		ea = ea_indexed (cpu, &cycles);
+		write16 (cpu, ea, cpu->reg_y);
+		inst_tst16 (cpu, cpu->reg_y);
+		return cycles;
+}
 
-	if (irq_f) {
-		if (get_cc (FLAG_F) == 0) {
-			if (irq_status != IRQ_CWAI) {
-				set_cc (FLAG_E, 0);
-				inst_psh (0x81, &reg_s, reg_u, &cycles);
-			}
+unsigned int ins_0x10_0xbf(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_extended (cpu);
+		write16 (cpu, ea, cpu->reg_y);
+		inst_tst16 (cpu, cpu->reg_y);
+		return 0;
+}
 
-			set_cc (FLAG_I, 1);
-			set_cc (FLAG_F, 1);
+	/* lds */
+unsigned int ins_0x10_0xce(e6809_t *cpu) {
+		cpu->reg_s = pc_read16 (cpu);
+		inst_tst16 (cpu, cpu->reg_s);
+		return 0;
+}
 
-			reg_pc = read16 (0xfff6);
-			irq_status = IRQ_NORMAL;
-			cycles += 7;
-		} else {
-			if (irq_status == IRQ_SYNC) {
-				irq_status = IRQ_NORMAL;
-			}
-		}
-	}
+unsigned int ins_0x10_0xde(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_direct (cpu);
+		cpu->reg_s = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_s);
+		return 0;
+}
 
-	if (irq_i) {
-		if (get_cc (FLAG_I) == 0) {
-			if (irq_status != IRQ_CWAI) {
-				set_cc (FLAG_E, 1);
-				inst_psh (0xff, &reg_s, reg_u, &cycles);
-			}
+unsigned int ins_0x10_0xee(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+	unsigned short  ea;
+		ea = ea_indexed (cpu, &cycles);
+		cpu->reg_s = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_s);
+		return cycles;
+}
+
+unsigned int ins_0x10_0xfe(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_extended (cpu);
+		cpu->reg_s = read16 (cpu, ea);
+		inst_tst16 (cpu, cpu->reg_s);
+		return 0;
+}
 
-			set_cc (FLAG_I, 1);
+	/* sts */
+unsigned int ins_0x10_0xdf(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_direct (cpu);
+		write16 (cpu, ea, cpu->reg_s);
+		inst_tst16 (cpu, cpu->reg_s);
+		return 0;
+}
 
-			reg_pc = read16 (0xfff8);
-			irq_status = IRQ_NORMAL;
-			cycles += 7;
-		} else {
-			if (irq_status == IRQ_SYNC) {
-				irq_status = IRQ_NORMAL;
-			}
-		}
-	}
+unsigned int ins_0x10_0xef(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+	unsigned short  ea;
+		ea = ea_indexed (cpu, &cycles);
+		write16 (cpu, ea, cpu->reg_s);
+		inst_tst16 (cpu, cpu->reg_s);
+		return cycles;
+}
 
-	if (irq_status != IRQ_NORMAL) {
-		return cycles + 1;
-	}
+unsigned int ins_0x10_0xff(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_extended (cpu);
+		write16 (cpu, ea, cpu->reg_s);
+		inst_tst16 (cpu, cpu->reg_s);
+		return 0;
+}
+
+	/* swi2 */
+unsigned int ins_0x10_0x3f(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		set_cc (cpu, FLAG_E, 1);
+		inst_psh (cpu, 0xff, &cpu->reg_s, cpu->reg_u, &cycles);
+		cpu->reg_pc = read16 (cpu, 0xfff4);
+		return cycles;
+}
 
-	op = pc_read8 ();
-	
-	cycles += opcodes[op]();
+	/* page 2 instructions */
 
-	return cycles;
+	/* cmpu */
+unsigned int ins_0x11_0x83(e6809_t *cpu) {
+		inst_sub16 (cpu, cpu->reg_u, pc_read16 (cpu));
+		return 0;
+}
+
+unsigned int ins_0x11_0x93(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_direct (cpu);
+		inst_sub16 (cpu, cpu->reg_u, read16 (cpu, ea));
+		return 0;
+}
+
+unsigned int ins_0x11_0xa3(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+	unsigned short  ea;
+		ea = ea_indexed (cpu, &cycles);
+		inst_sub16 (cpu, cpu->reg_u, read16 (cpu, ea));
+		return cycles;
+}
+
+unsigned int ins_0x11_0xb3(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_extended (cpu);
+		inst_sub16 (cpu, cpu->reg_u, read16 (cpu, ea));
+		return 0;
+}
+
+	/* cmps */
+unsigned int ins_0x11_0x8c(e6809_t *cpu) {
+		inst_sub16 (cpu, cpu->reg_s, pc_read16 (cpu));
+		return 0;
+}
+
+unsigned int ins_0x11_0x9c(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_direct (cpu);
+		inst_sub16 (cpu, cpu->reg_s, read16 (cpu, ea));
+		return 0;
+}
+
+unsigned int ins_0x11_0xac(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+	unsigned short  ea;
+		ea = ea_indexed (cpu, &cycles);
+		inst_sub16 (cpu, cpu->reg_s, read16 (cpu, ea));
+		return cycles;
+}
+
+unsigned int ins_0x11_0xbc(e6809_t *cpu) {
+	unsigned short  ea;
+		ea = ea_extended (cpu);
+		inst_sub16 (cpu, cpu->reg_s, read16 (cpu, ea));
+		return 0;
+}
+
+	/* swi3 */
+unsigned int ins_0x11_0x3f(e6809_t *cpu) {
+	unsigned short  cycles = 0;
+		set_cc (cpu, FLAG_E, 1);
+		inst_psh (cpu, 0xff, &cpu->reg_s, cpu->reg_u, &cycles);
+		cpu->reg_pc = read16 (cpu, 0xfff2);
+		return cycles;
+}
+
+
+unsigned int ins_err(e6809_t *cpu) {
+		printf ("unknown page-0 op code\n");
+		return 0;
+	}
+
+unsigned int ins_err1(e6809_t *cpu) {
+		printf ("unknown page-1 op code: %.2x\n", cpu->fetch[-1]);
+		return 0;
+}
+
+unsigned int ins_err2(e6809_t *cpu) {
+		printf ("unknown page-2 op code: %.2x\n", cpu->fetch[-1]);
+		return 0;
+}
+
+/* handlers of the op codes of page 0, 1 and 2. 0x10 and 0x11 are only
+ * prefixes, the decoder looks up the op code that follows in page 1 or 2.
+ */
+
+unsigned int (* opcodes[3][256])(e6809_t *cpu) = {
+	{
+		ins_0x00, ins_err , ins_err , ins_0x03, ins_0x04, ins_err , ins_0x06, ins_0x07, ins_0x08, ins_0x09, ins_0x0a, ins_err , ins_0x0c, ins_0x0d, ins_0x0e, ins_0x0f,
+		ins_err , ins_err , ins_0x12, ins_0x13, ins_err , ins_err , ins_0x16, ins_0x17, ins_err , ins_0x19, ins_0x1a, ins_err , ins_0x1c, ins_0x1d, ins_0x1e, ins_0x1f,
+		ins_0x20, ins_0x21, ins_0x22, ins_0x23, ins_0x24, ins_0x25, ins_0x26, ins_0x27, ins_0x28, ins_0x29, ins_0x2a, ins_0x2b, ins_0x2c, ins_0x2d, ins_0x2e, ins_0x2f,
+		ins_0x30, ins_0x31, ins_0x32, ins_0x33, ins_0x34, ins_0x35, ins_0x36, ins_0x37, ins_err , ins_0x39, ins_0x3a, ins_0x3b, ins_0x3c, ins_0x3d, ins_err , ins_0x3f,
+		ins_0x40, ins_err , ins_err , ins_0x43, ins_0x44, ins_err , ins_0x46, ins_0x47, ins_0x48, ins_0x49, ins_0x4a, ins_err , ins_0x4c, ins_0x4d, ins_err , ins_0x4f,
+		ins_0x50, ins_err , ins_err , ins_0x53, ins_0x54, ins_err , ins_0x56, ins_0x57, ins_0x58, ins_0x59, ins_0x5a, ins_err , ins_0x5c, ins_0x5d, ins_err , ins_0x5f,
+		ins_0x60, ins_err , ins_err , ins_0x63, ins_0x64, ins_err , ins_0x66, ins_0x67, ins_0x68, ins_0x69, ins_0x6a, ins_err , ins_0x6c, ins_0x6d, ins_0x6e, ins_0x6f,
+		ins_0x70, ins_err , ins_err , ins_0x73, ins_0x74, ins_err , ins_0x76, ins_0x77, ins_0x78, ins_0x79, ins_0x7a, ins_err , ins_0x7c, ins_0x7d, ins_0x7e, ins_0x7f,
+		ins_0x80, ins_0x81, ins_0x82, ins_0x83, ins_0x84, ins_0x85, ins_0x86, ins_err , ins_0x88, ins_0x89, ins_0x8a, ins_0x8b, ins_0x8c, ins_0x8d, ins_0x8e, ins_err ,
+		ins_0x90, ins_0x91, ins_0x92, ins_0x93, ins_0x94, ins_0x95, ins_0x96, ins_0x97, ins_0x98, ins_0x99, ins_0x9a, ins_0x9b, ins_0x9c, ins_0x9d, ins_0x9e, ins_0x9f,
+		ins_0xa0, ins_0xa1, ins_0xa2, ins_0xa3, ins_0xa4, ins_0xa5, ins_0xa6, ins_0xa7, ins_0xa8, ins_0xa9, ins_0xaa, ins_0xab, ins_0xac, ins_0xad, ins_0xae, ins_0xaf,
+		ins_0xb0, ins_0xb1, ins_0xb2, ins_0xb3, ins_0xb4, ins_0xb5, ins_0xb6, ins_0xb7, ins_0xb8, ins_0xb9, ins_0xba, ins_0xbb, ins_0xbc, ins_0xbd, ins_0xbe, ins_0xbf,
+		ins_0xc0, ins_0xc1, ins_0xc2, ins_0xc3, ins_0xc4, ins_0xc5, ins_0xc6, ins_err , ins_0xc8, ins_0xc9, ins_0xca, ins_0xcb, ins_0xcc, ins_err , ins_0xce, ins_err ,
+		ins_0xd0, ins_0xd1, ins_0xd2, ins_0xd3, ins_0xd4, ins_0xd5, ins_0xd6, ins_0xd7, ins_0xd8, ins_0xd9, ins_0xda, ins_0xdb, ins_0xdc, ins_0xdd, ins_0xde, ins_0xdf,
+		ins_0xe0, ins_0xe1, ins_0xe2, ins_0xe3, ins_0xe4, ins_0xe5, ins_0xe6, ins_0xe7, ins_0xe8, ins_0xe9, ins_0xea, ins_0xeb, ins_0xec, ins_0xed, ins_0xee, ins_0xef,
+		ins_0xf0, ins_0xf1, ins_0xf2, ins_0xf3, ins_0xf4, ins_0xf5, ins_0xf6, ins_0xf7, ins_0xf8, ins_0xf9, ins_0xfa, ins_0xfb, ins_0xfc, ins_0xfd, ins_0xfe, ins_0xff
+	}, {
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     ,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     ,
+		ins_0x10_0x20, ins_0x10_0x21, ins_0x10_0x22, ins_0x10_0x23, ins_0x10_0x24, ins_0x10_0x25, ins_0x10_0x26, ins_0x10_0x27, ins_0x10_0x28, ins_0x10_0x29, ins_0x10_0x2a, ins_0x10_0x2b, ins_0x10_0x2c, ins_0x10_0x2d, ins_0x10_0x2e, ins_0x10_0x2f,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0x3f,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     ,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     ,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     ,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     ,
+		ins_err1     , ins_err1     , ins_err1     , ins_0x10_0x83, ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0x8c, ins_err1     , ins_0x10_0x8e, ins_err1     ,
+		ins_err1     , ins_err1     , ins_err1     , ins_0x10_0x93, ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0x9c, ins_err1     , ins_0x10_0x9e, ins_0x10_0x9f,
+		ins_err1     , ins_err1     , ins_err1     , ins_0x10_0xa3, ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0xac, ins_err1     , ins_0x10_0xae, ins_0x10_0xaf,
+		ins_err1     , ins_err1     , ins_err1     , ins_0x10_0xb3, ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0xbc, ins_err1     , ins_0x10_0xbe, ins_0x10_0xbf,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0xce, ins_err1     ,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0xde, ins_0x10_0xdf,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0xee, ins_0x10_0xef,
+		ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_err1     , ins_0x10_0xfe, ins_0x10_0xff
+	}, {
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_0x11_0x3f,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_0x11_0x83, ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_0x11_0x8c, ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_0x11_0x93, ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_0x11_0x9c, ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_0x11_0xa3, ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_0x11_0xac, ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_0x11_0xb3, ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_0x11_0xbc, ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     ,
+		ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2     , ins_err2
+	}
+};
+
+/* superinstructions. a fused pair runs two instructions that often
+ * follow each other with a single dispatch and a single trip through
+ * the cache, the compiler is free to inline both handlers into it.
+ *
+ * the pair has to behave exactly like the two instructions on their own:
+ * the second half only runs if the plain interpreter would also have gone
+ * straight on to it, i.e. within e6809_run, with budget left and no
+ * e6809_sync from the first half. then the cycles of the first half are
+ * booked before the second starts, so e6809_elapsed is right for both
+ * halves. otherwise the pair ends after the first instruction like a
+ * plain one. fused entries have no base cycles, the handler returns them
+ * all. only instructions that fall through to the next one qualify as a
+ * first half.
+ */
+
+/* a profiling build runs without fused pairs, see e6809_run, but the
+ * threaded loop still lays out its table after this one.
+ */
+
+#if !defined (E6809_PROFILE) || defined (E6809_THREADED)
+static einline unsigned short  fuse_split (e6809_t *cpu, unsigned int cycles)
+{
+	if (cpu->run_sync || cpu->run_cycles + (int) cycles >= cpu->run_limit) {
+		return 1;
+	}
+
+	cpu->run_cycles += cycles;
+
+	/* skip the op code of the second instruction */
+
+	cpu->fetch++;
+	cpu->reg_pc++;
+
+	return 0;
+}
+
+#define FUSE(a, b) \
+static unsigned int fuse_##a##_##b (e6809_t *cpu) \
+{ \
+	unsigned int cycles; \
+ \
+	cycles = e6809_ops[0][a].cycles + ins_##a (cpu); \
+ \
+	if (fuse_split (cpu, cycles)) { \
+		return cycles; \
+	} \
+ \
+	return e6809_ops[0][b].cycles + ins_##b (cpu); \
+}
+
+/* the pairs, picked from the op code sequence profile of the bios and a
+ * few games. mostly the delay and polling loops of the bios and the
+ * stores to the via that drive the beam.
+ */
+
+FUSE(0x5a, 0x26) /* decb; bne */
+FUSE(0x4a, 0x26) /* deca; bne */
+FUSE(0x12, 0x5a) /* nop; decb */
+FUSE(0x86, 0x12) /* lda #; nop */
+FUSE(0xd5, 0x27) /* bitb <; beq */
+FUSE(0x5c, 0x2a) /* incb; bpl */
+FUSE(0xa6, 0x2a) /* lda idx; bpl */
+FUSE(0xa6, 0x2f) /* lda idx; ble */
+FUSE(0x81, 0x23) /* cmpa #; bls */
+FUSE(0x81, 0x26) /* cmpa #; bne */
+FUSE(0xc1, 0x26) /* cmpb #; bne */
+FUSE(0x86, 0x97) /* lda #; sta < */
+FUSE(0xc6, 0xd7) /* ldb #; stb < */
+FUSE(0xa6, 0x97) /* lda idx; sta < */
+FUSE(0xec, 0x97) /* ldd idx; sta < */
+FUSE(0x97, 0xa6) /* sta <; lda idx */
+FUSE(0x97, 0x0f) /* sta <; clr < */
+FUSE(0x97, 0xd7) /* sta <; stb < */
+FUSE(0xd7, 0x97) /* stb <; sta < */
+FUSE(0x0c, 0xd7) /* inc <; stb < */
+FUSE(0x12, 0x97) /* nop; sta < */
+
+static const struct {
+	unsigned char a, b;
+	unsigned int (*handler) (e6809_t *cpu);
+} fusions[] = {
+	{0x5a, 0x26, fuse_0x5a_0x26},
+	{0x4a, 0x26, fuse_0x4a_0x26},
+	{0x12, 0x5a, fuse_0x12_0x5a},
+	{0x86, 0x12, fuse_0x86_0x12},
+	{0xd5, 0x27, fuse_0xd5_0x27},
+	{0x5c, 0x2a, fuse_0x5c_0x2a},
+	{0xa6, 0x2a, fuse_0xa6_0x2a},
+	{0xa6, 0x2f, fuse_0xa6_0x2f},
+	{0x81, 0x23, fuse_0x81_0x23},
+	{0x81, 0x26, fuse_0x81_0x26},
+	{0xc1, 0x26, fuse_0xc1_0x26},
+	{0x86, 0x97, fuse_0x86_0x97},
+	{0xc6, 0xd7, fuse_0xc6_0xd7},
+	{0xa6, 0x97, fuse_0xa6_0x97},
+	{0xec, 0x97, fuse_0xec_0x97},
+	{0x97, 0xa6, fuse_0x97_0xa6},
+	{0x97, 0x0f, fuse_0x97_0x0f},
+	{0x97, 0xd7, fuse_0x97_0xd7},
+	{0xd7, 0x97, fuse_0xd7_0x97},
+	{0x0c, 0xd7, fuse_0x0c_0xd7},
+	{0x12, 0x97, fuse_0x12_0x97}
+};
+#endif
+
+/* traps, see e6809_trap. the decoder puts ins_trap in place of the
+ * handler of a trapped instruction, without op code bytes so that the pc
+ * still points at it. if the trap declines, ins_trap runs the instruction
+ * itself.
+ */
+
+static unsigned short  trap_find (e6809_t *cpu, unsigned short  pc)
+{
+	unsigned short  i;
+
+	for (i = 0; i < cpu->traps; i++) {
+		if (cpu->trap_pc[i] == pc) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static unsigned int ins_trap (e6809_t *cpu)
+{
+	unsigned short  i, page, op;
+	int start, done;
+
+	i = trap_find (cpu, cpu->reg_pc);
+
+	if (i < cpu->traps) {
+		start = cpu->run_cycles;
+
+		if (cpu->trap_fn[i] (cpu)) {
+			/* the caller books the cycles the trap spent */
+
+			done = cpu->run_cycles - start;
+			cpu->run_cycles = start;
+
+			return done;
+		}
+	}
+
+	page = 0;
+	op = cpu->fetch[0];
+
+	if (op == 0x10 || op == 0x11) {
+		page = op - 0x0f;
+		op = cpu->fetch[1];
+	}
+
+	cpu->fetch += page ? 2 : 1;
+	cpu->reg_pc += page ? 2 : 1;
+
+	return e6809_ops[page][op].cycles + opcodes[page][op] (cpu);
+}
+
+/* fetch and decode the instruction at pc */
+
+static void dcache_decode (e6809_t *cpu, dcache_t *e, unsigned short  pc)
+{
+	const e6809_opinfo_t *op;
+	unsigned short  len, i;
+
+	e->bytes[0] = read8 (cpu, pc);
+	e->handler = opcodes[0][e->bytes[0]];
+	op = &e6809_ops[0][e->bytes[0]];
+	e->oplen = 1;
+
+	if (op->mode == E6809_AM_PAGE) {
+		e->bytes[1] = read8 (cpu, pc + 1);
+		e->handler = opcodes[e->bytes[0] - 0x0f][e->bytes[1]];
+		op = &e6809_ops[e->bytes[0] - 0x0f][e->bytes[1]];
+		e->oplen = 2;
+	}
+
+	i = e->oplen;
+	len = op->len;
+
+	if (op->mode == E6809_AM_ILL) {
+		len = i;
+	} else if (op->mode == E6809_AM_IDX) {
+		/* the post byte tells how many more bytes follow */
+
+		e->bytes[i] = read8 (cpu, pc + i);
+		len += e6809_postbytes[e->bytes[i]].len;
+		i++;
+	}
+
+	for (; i < len; i++) {
+		e->bytes[i] = read8 (cpu, pc + i);
+	}
+
+	e->pc = pc;
+	e->len = len;
+	e->mode = op->mode;
+	e->cycles = op->cycles;
+
+#ifdef E6809_THREADED
+	e->thread = e->bytes[0];
+
+	if (e->oplen == 2) {
+		e->thread = ((e->bytes[0] - 0x0f) << 8) | e->bytes[1];
+	}
+#endif
+
+	if (cpu->trap_page[pc >> 8] && trap_find (cpu, pc) < cpu->traps) {
+		e->handler = ins_trap;
+		e->oplen = 0;
+		e->cycles = 0;
+#ifdef E6809_THREADED
+		/* the call after the fused pairs in run_threaded */
+
+		e->thread = 3 * 256 + sizeof (fusions) / sizeof (fusions[0]);
+#endif
+	}
+}
+
+/* can an instruction of len bytes at pc be cached? all of it has to come
+ * from one cacheable region.
+ */
+
+static einline unsigned short  dcache_cacheable (e6809_t *cpu, unsigned short  pc, unsigned short  len)
+{
+	unsigned short  first, last;
+
+	first = pc >> 8;
+	last = ((pc + len - 1) & 0xffff) >> 8;
+
+	if ((cpu->dcache_page[first] & DCACHE_EXEC) == 0 ||
+		(cpu->dcache_page[last] & DCACHE_EXEC) == 0) {
+		return 0;
+	}
+
+	return ((cpu->dcache_alias[last] - cpu->dcache_alias[first]) & 0xff) == ((last - first) & 0xff);
+}
+
+#ifndef E6809_PROFILE
+/* turn the freshly decoded instruction e into a fused pair if it and the
+ * one after it are in fusions[] and both fit in one entry. only done for
+ * memory that is never written: a write by the first half could otherwise
+ * change the second one after it was decoded.
+ */
+
+static void dcache_fuse (e6809_t *cpu, dcache_t *e)
+{
+	dcache_t next;
+	unsigned short  i, len;
+
+	if (e->handler == ins_trap) {
+		return;
+	}
+
+	for (i = 0; i < sizeof (fusions) / sizeof (fusions[0]); i++) {
+		if (fusions[i].a == e->bytes[0]) {
+			break;
+		}
+	}
+
+	if (i == sizeof (fusions) / sizeof (fusions[0])) {
+		return;
+	}
+
+	dcache_decode (cpu, &next, e->pc + e->len);
+	len = e->len + next.len;
+
+	if (next.handler == ins_trap || len > E6809_DCACHE_MAXLEN || !dcache_cacheable (cpu, e->pc, len) ||
+		(cpu->dcache_page[((e->pc + len - 1) & 0xffff) >> 8] & DCACHE_WATCH)) {
+		return;
+	}
+
+	for (; i < sizeof (fusions) / sizeof (fusions[0]); i++) {
+		if (fusions[i].a == e->bytes[0] && fusions[i].b == next.bytes[0]) {
+			memcpy (e->bytes + e->len, next.bytes, next.len);
+			e->handler = fusions[i].handler;
+			e->len = len;
+			e->cycles = 0;
+#ifdef E6809_THREADED
+			e->thread = 3 * 256 + i;
+#endif
+			return;
+		}
+	}
+}
+#endif
+
+/* decode the instruction at pc into its slot e, or into the scratch entry
+ * if it cannot be cached
+ */
+
+static dcache_t *dcache_miss (e6809_t *cpu, dcache_t *e, unsigned short  pc)
+{
+	dcache_decode (cpu, &cpu->scratch, pc);
+
+	if (!dcache_cacheable (cpu, pc, cpu->scratch.len)) {
+		return &cpu->scratch;
+	}
+
+	if (e->len && (cpu->dcache_page[e->pc >> 8] & DCACHE_WATCH)) {
+		cpu->dcache_watched--;
+	}
+
+	if (cpu->dcache_page[pc >> 8] & DCACHE_WATCH) {
+		cpu->dcache_watched++;
+	}
+
+	*e = cpu->scratch;
+
+#ifndef E6809_PROFILE
+	/* see e6809_run */
+
+	if (cpu->fuse && (cpu->dcache_page[pc >> 8] & DCACHE_WATCH) == 0) {
+		dcache_fuse (cpu, e);
+	}
+#endif
+
+	return e;
+}
+
+/* look up the decoded instruction at pc, decoding it on a miss */
+
+static einline dcache_t *dcache_fetch (e6809_t *cpu, unsigned short  pc)
+{
+	dcache_t *e;
+
+	e = &cpu->dcache[pc & (DCACHE_SIZE - 1)];
+
+	if (e->pc == pc && e->len) {
+		return e;
+	}
+
+	return dcache_miss (cpu, e, pc);
+}
+
+#ifdef E6809_PROFILE
+
+/* execution profile. counts and cycles of every op code (page 1 and 2 op
+ * codes are told apart by their prefix) and how often each sequence of 2
+ * and 3 op codes was executed. the sequences go to open addressed hash
+ * tables, keyed by the packed op codes plus one so that 0 is free.
+ */
+
+enum {
+	PROF_OPS	= 3 * 256,
+	PROF_NGRAMS	= 1 << 16  /* slots per sequence table, a power of two */
+};
+
+typedef struct {
+	unsigned long key;
+	unsigned long count;
+} ngram_t;
+
+struct e6809_profile {
+	unsigned long count[PROF_OPS];
+	unsigned long cycles[PROF_OPS];
+	ngram_t seq2[PROF_NGRAMS];
+	ngram_t seq3[PROF_NGRAMS];
+	unsigned long lost;   /* sequences that did not fit */
+	unsigned long idle;   /* cycles skipped in idle loops */
+	unsigned prev[2];     /* the last two op codes, most recent first */
+};
+
+static void ngram_count (e6809_t *cpu, ngram_t *table, unsigned long key)
+{
+	unsigned i, n;
+
+	i = (unsigned) ((key * 2654435761u) >> 8) & (PROF_NGRAMS - 1);
+
+	for (n = 0; n < PROF_NGRAMS; n++, i = (i + 1) & (PROF_NGRAMS - 1)) {
+		if (table[i].key == key) {
+			table[i].count++;
+			return;
+		}
+
+		if (table[i].key == 0) {
+			table[i].key = key;
+			table[i].count = 1;
+			return;
+		}
+	}
+
+	cpu->profile->lost++;
+}
+
+static void profile_count (e6809_t *cpu, const dcache_t *e, unsigned cycles)
+{
+	struct e6809_profile *p;
+	unsigned op;
+
+	p = cpu->profile;
+
+	if (p == NULL) {
+		p = calloc (1, sizeof (*p));
+
+		if (p == NULL) {
+			return;
+		}
+
+		p->prev[0] = p->prev[1] = PROF_OPS;
+		cpu->profile = p;
+	}
+
+	op = e->bytes[0];
+
+	if (op == 0x10 || op == 0x11) {
+		op = ((op - 0x0f) << 8) | e->bytes[1];
+	}
+
+	p->count[op]++;
+	p->cycles[op] += cycles;
+
+	if (p->prev[0] != PROF_OPS) {
+		ngram_count (cpu, p->seq2, ((unsigned long) p->prev[0] << 10 | op) + 1);
+
+		if (p->prev[1] != PROF_OPS) {
+			ngram_count (cpu, p->seq3,
+				((unsigned long) p->prev[1] << 20 | (unsigned long) p->prev[0] << 10 | op) + 1);
+		}
+	}
+
+	p->prev[1] = p->prev[0];
+	p->prev[0] = op;
+}
+
+#endif
+
+/* execute the instruction at pc and return the number of cycles it took */
+
+static einline unsigned short  e6809_exec (e6809_t *cpu)
+{
+	dcache_t *e;
+
+	e = dcache_fetch (cpu, cpu->reg_pc);
+
+	cpu->fetch = e->bytes + e->oplen;
+	cpu->reg_pc += e->oplen;
+
+#ifdef E6809_PROFILE
+	{
+		unsigned cycles;
+
+		cycles = e->cycles + e->handler (cpu);
+		profile_count (cpu, e, cycles);
+
+		return cycles;
+	}
+#else
+	return e->cycles + e->handler (cpu);
+#endif
+}
+
+/* execute a single instruction or handle interrupts and return */
+
+unsigned short  e6809_sstep (e6809_t *cpu, unsigned short  irq_i, unsigned short  irq_f)
+{
+	unsigned short  cycles = 0;
+
+	if (irq_f) {
+		if (get_cc (cpu, FLAG_F) == 0) {
+			if (cpu->irq_status != IRQ_CWAI) {
+				set_cc (cpu, FLAG_E, 0);
+				inst_psh (cpu, 0x81, &cpu->reg_s, cpu->reg_u, &cycles);
+			}
+
+			set_cc (cpu, FLAG_I, 1);
+			set_cc (cpu, FLAG_F, 1);
+
+			cpu->reg_pc = read16 (cpu, 0xfff6);
+			cpu->irq_status = IRQ_NORMAL;
+			cycles += 7;
+		} else {
+			if (cpu->irq_status == IRQ_SYNC) {
+				cpu->irq_status = IRQ_NORMAL;
+			}
+		}
+	}
+
+	if (irq_i) {
+		if (get_cc (cpu, FLAG_I) == 0) {
+			if (cpu->irq_status != IRQ_CWAI) {
+				set_cc (cpu, FLAG_E, 1);
+				inst_psh (cpu, 0xff, &cpu->reg_s, cpu->reg_u, &cycles);
+			}
+
+			set_cc (cpu, FLAG_I, 1);
+
+			cpu->reg_pc = read16 (cpu, 0xfff8);
+			cpu->irq_status = IRQ_NORMAL;
+			cycles += 7;
+		} else {
+			if (cpu->irq_status == IRQ_SYNC) {
+				cpu->irq_status = IRQ_NORMAL;
+			}
+		}
+	}
+
+	if (cpu->irq_status != IRQ_NORMAL) {
+		return cycles + 1;
+	}
+
+	cycles += e6809_exec (cpu);
+
+	return cycles;
+}
+
+/* idle loop detection. a backward jump of at most IDLE_MAXLEN bytes is a
+ * candidate. if the cpu comes back to the same place with the registers
+ * unchanged, nothing written and no volatile i/o read on the way, the
+ * next trip round the loop will do exactly the same again, and so will
+ * all the following ones until a peripheral event changes what the loop
+ * reads. e6809_run then adds the cycles of as many whole trips as fit in
+ * its budget instead of executing them.
+ */
+
+enum {
+	IDLE_MAXLEN	= 16
+};
+
+typedef struct {
+	unsigned short pc;
+	unsigned short x, y, u, s, a, b, dp, cc;
+	int cycles;
+} idle_t;
+
+static einline void idle_check (e6809_t *cpu, idle_t *idle, int cycles)
+{
+	unsigned short  cc;
+	int trip;
+
+	cc = get_reg_cc (cpu);
+
+	if (cpu->run_wrote == 0 && cpu->run_volatile == 0 &&
+		idle->pc == cpu->reg_pc && idle->cc == cc &&
+		idle->a == cpu->reg_a && idle->b == cpu->reg_b &&
+		idle->x == cpu->reg_x && idle->y == cpu->reg_y &&
+		idle->u == cpu->reg_u && idle->s == cpu->reg_s &&
+		idle->dp == cpu->reg_dp) {
+		trip = cpu->run_cycles - idle->cycles;
+
+		if (trip > 0 && cpu->run_cycles < cycles) {
+			trip *= (cycles - cpu->run_cycles) / trip;
+			cpu->run_cycles += trip;
+
+#ifdef E6809_PROFILE
+			if (cpu->profile) {
+				cpu->profile->idle += trip;
+			}
+#endif
+		}
+	}
+
+	idle->pc = cpu->reg_pc;
+	idle->x = cpu->reg_x;
+	idle->y = cpu->reg_y;
+	idle->u = cpu->reg_u;
+	idle->s = cpu->reg_s;
+	idle->a = cpu->reg_a;
+	idle->b = cpu->reg_b;
+	idle->dp = cpu->reg_dp;
+	idle->cc = cc;
+	idle->cycles = cpu->run_cycles;
+
+	cpu->run_wrote = 0;
+	cpu->run_volatile = 0;
+}
+
+/* basic block translator. straight-line code in rom is translated once
+ * into a short list of micro-ops that the block executes with the 6809
+ * registers and the condition codes in locals. a liveness pass over the
+ * list drops the flag updates that are overwritten before anything looks
+ * at them. a block ends at a branch (which it includes), at the first
+ * instruction it cannot translate and at direct or extended accesses to
+ * i/o, which are left to the interpreter. indexed accesses are checked
+ * when they happen: one that hits i/o leaves the block before its
+ * instruction (a side exit), so every flag is live there.
+ *
+ * a block only runs if the plain interpreter would also have run all of
+ * it in one go, i.e. within e6809_run with enough budget left. since it
+ * never touches i/o nothing in it can end the run early. code in ram is
+ * never translated, it runs on the interpreter.
+ */
+
+enum {
+	BLOCK_MININSN	= 2,   /* shorter blocks are left to the interpreter */
+	BLOCK_MAXINSN	= 12,
+	BLOCK_INSNUOPS	= 4    /* the most micro-ops one instruction needs */
+};
+
+/* micro-ops. ea and the temporary t are the operands of the memory ones. */
+
+enum {
+	U_EA,     /* ea = arg */
+	U_IDX,    /* ea = indexed address (aux is the E6809_IDX_* kind), may exit */
+	U_IMM,    /* t = arg */
+	U_RD8,    /* t = [ea] */
+	U_RD16,
+	U_WR8,    /* [ea] = reg */
+	U_ST8,    /* [ea] = reg, with flags */
+	U_ST16,
+	U_LD8,    /* reg = t, with flags */
+	U_LD16,
+	U_ADD8,   /* reg = reg op t */
+	U_SUB8,
+	U_CMP8,
+	U_AND8,
+	U_BIT8,
+	U_EOR8,
+	U_OR8,
+	U_ADD16,
+	U_SUB16,
+	U_CMP16,
+	U_NEG,    /* reg = op reg */
+	U_COM,
+	U_LSR,
+	U_ASR,
+	U_ASL,
+	U_DEC,
+	U_INC,
+	U_TST,
+	U_CLR,
+	U_LEA,    /* reg = ea, z flag if aux */
+	U_BCC,    /* branch to arg if condition aux holds, ends the block */
+	U_END     /* continue at arg, ends the block */
+};
+
+/* registers of a block. x to s are numbered like E6809_REG_*. */
+
+enum {
+	R_X, R_Y, R_U, R_S, R_A, R_B, R_T,
+	R_COUNT,
+	R_D = R_COUNT /* a and b, 16-bit micro-ops only */
+};
+
+/* access of a memory micro-op */
+
+enum {
+	IO_RD	= 1,
+	IO_WR	= 2,
+	IO_WORD	= 4
+};
+
+/* the flags each micro-op sets */
+
+static const unsigned char uop_sets[] = {
+	0, 0, 0, 0, 0, 0,
+	FLAG_N | FLAG_Z | FLAG_V,                   /* st8 */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* st16 */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* ld8 */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* ld16 */
+	FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, /* add8 */
+	FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, /* sub8 */
+	FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, /* cmp8 */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* and8 */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* bit8 */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* eor8 */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* or8 */
+	FLAG_N | FLAG_Z | FLAG_V | FLAG_C,          /* add16 */
+	FLAG_N | FLAG_Z | FLAG_V | FLAG_C,          /* sub16 */
+	FLAG_N | FLAG_Z | FLAG_V | FLAG_C,          /* cmp16 */
+	FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, /* neg */
+	FLAG_N | FLAG_Z | FLAG_V | FLAG_C,          /* com */
+	FLAG_N | FLAG_Z | FLAG_C,                   /* lsr */
+	FLAG_N | FLAG_Z | FLAG_C,                   /* asr */
+	FLAG_H | FLAG_N | FLAG_Z | FLAG_V | FLAG_C, /* asl */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* dec */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* inc */
+	FLAG_N | FLAG_Z | FLAG_V,                   /* tst */
+	FLAG_N | FLAG_Z | FLAG_V | FLAG_C,          /* clr */
+	FLAG_Z,                                     /* lea */
+	0, 0
+};
+
+/* read-modify-write instructions by the low nibble of the op code */
+
+static const unsigned char block_unary[16] = {
+	U_NEG, 0, 0, U_COM, U_LSR, 0, 0, U_ASR,
+	U_ASL, 0, U_DEC, 0, U_INC, U_TST, 0, U_CLR
+};
+
+/* would an access to ea go to an i/o handler? */
+
+static einline unsigned short  block_io (e6809_t *cpu, unsigned short  ea, unsigned short  io)
+{
+	unsigned short  last;
+
+	last = ea + ((io & IO_WORD) != 0);
+
+	if ((io & IO_RD) && (cpu->map_rd[ea >> 8] == NULL || cpu->map_rd[last >> 8] == NULL)) {
+		return 1;
+	}
+
+	if ((io & IO_WR) && (cpu->map_wr[ea >> 8] == NULL || cpu->map_wr[last >> 8] == NULL)) {
+		return 1;
+	}
+
+	return 0;
+}
+
+static e6809_uop_t *block_emit (e6809_block_t *b, unsigned short  op,
+	unsigned short  reg, unsigned short  arg)
+{
+	e6809_uop_t *u;
+
+	u = &b->uops[b->nuops++];
+	u->op = op;
+	u->reg = reg;
+	u->flags = 0;
+	u->aux = 0;
+	u->io = 0;
+	u->arg = arg;
+
+	return u;
+}
+
+/* emit the micro-ops that compute the effective address of d into ea.
+ * fails for indirect modes and direct or extended i/o accesses.
+ */
+
+static unsigned short  block_ea (e6809_t *cpu, e6809_block_t *b, const dcache_t *d,
+	unsigned short  io, unsigned short  *extra)
+{
+	const e6809_postbyte_t *pb;
+	e6809_uop_t *u;
+	unsigned short  ea, offset;
+
+	switch (d->mode) {
+	case E6809_AM_DIR:
+		ea = (cpu->reg_dp << 8) | d->bytes[1];
+		b->dp_used = 1;
+		break;
+	case E6809_AM_EXT:
+		ea = (d->bytes[1] << 8) | d->bytes[2];
+		break;
+	case E6809_AM_IDX:
+		pb = &e6809_postbytes[d->bytes[1]];
+
+		if (pb->indirect) {
+			return 0;
+		}
+
+		switch (pb->kind) {
+		case E6809_IDX_OFF5:
+		case E6809_IDX_INC:
+		case E6809_IDX_DEC:
+			offset = pb->offset;
+			break;
+		case E6809_IDX_OFF8:
+			offset = sign_extend (d->bytes[2]);
+			break;
+		case E6809_IDX_OFF16:
+			offset = (d->bytes[2] << 8) | d->bytes[3];
+			break;
+		case E6809_IDX_ZERO:
+		case E6809_IDX_A:
+		case E6809_IDX_B:
+		case E6809_IDX_D:
+			offset = 0;
+			break;
+		default:
+			return 0;
+		}
+
+		*extra = pb->cycles;
+
+		if (pb->reg != E6809_REG_PC) {
+			u = block_emit (b, U_IDX, pb->reg, offset);
+			u->aux = pb->kind;
+			u->io = io;
+
+			return 1;
+		}
+
+		/* pc relative, the pc is past the offset by then */
+
+		ea = d->pc + d->len + offset;
+		break;
+	default:
+		return 0;
+	}
+
+	if (block_io (cpu, ea, io)) {
+		return 0;
+	}
+
+	block_emit (b, U_EA, 0, ea);
+
+	return 1;
+}
+
+/* emit the micro-ops of one page 0 instruction. fails for everything
+ * that changes the flow of control other than the short branches,
+ * touches the stack or needs the carry as an input.
+ */
+
+static unsigned short  block_insn (e6809_t *cpu, e6809_block_t *b, const dcache_t *d,
+	unsigned short  *extra)
+{
+	static const unsigned char lea_regs[4] = {R_X, R_Y, R_S, R_U};
+	unsigned short  op, lo, hi, uop, reg, width, io;
+
+	op = d->bytes[0];
+	hi = op >> 4;
+	lo = op & 0xf;
+
+	if (d->oplen != 1 || d->mode == E6809_AM_ILL) {
+		return 0;
+	}
+
+	if (op == 0x12) {
+		/* nop */
+
+		return 1;
+	}
+
+	if (hi == 0x2) {
+		block_emit (b, U_BCC, 0, d->pc + 2 + sign_extend (d->bytes[1]))->aux = op;
+
+		return 1;
+	}
+
+	if (op >= 0x30 && op <= 0x33) {
+		if (!block_ea (cpu, b, d, 0, extra)) {
+			return 0;
+		}
+
+		block_emit (b, U_LEA, lea_regs[op & 3], 0)->aux = op < 0x32;
+
+		return 1;
+	}
+
+	if (hi == 0x0 || (hi >= 0x4 && hi <= 0x7)) {
+		uop = block_unary[lo];
+
+		if (uop == 0) {
+			return 0;
+		}
+
+		if (hi == 0x4 || hi == 0x5) {
+			block_emit (b, uop, hi == 0x4 ? R_A : R_B, 0);
+
+			return 1;
+		}
+
+		io = uop == U_CLR ? IO_WR : uop == U_TST ? IO_RD : IO_RD | IO_WR;
+
+		if (!block_ea (cpu, b, d, io, extra)) {
+			return 0;
+		}
+
+		if (uop != U_CLR) {
+			block_emit (b, U_RD8, R_T, 0);
+		}
+
+		block_emit (b, uop, R_T, 0);
+
+		if (uop != U_TST) {
+			block_emit (b, U_WR8, R_T, 0);
+		}
+
+		return 1;
+	}
+
+	if (hi < 0x8) {
+		return 0;
+	}
+
+	/* the accumulator and 16-bit register instructions */
+
+	reg = hi < 0xc ? R_A : R_B;
+	width = 1;
+
+	switch (lo) {
+	case 0x0: uop = U_SUB8; break;
+	case 0x1: uop = U_CMP8; break;
+	case 0x4: uop = U_AND8; break;
+	case 0x5: uop = U_BIT8; break;
+	case 0x6: uop = U_LD8; break;
+	case 0x7: uop = U_ST8; break;
+	case 0x8: uop = U_EOR8; break;
+	case 0xa: uop = U_OR8; break;
+	case 0xb: uop = U_ADD8; break;
+	case 0x3:
+		uop = reg == R_A ? U_SUB16 : U_ADD16;
+		reg = R_D;
+		width = 2;
+		break;
+	case 0xc:
+		uop = reg == R_A ? U_CMP16 : U_LD16;
+		reg = reg == R_A ? R_X : R_D;
+		width = 2;
+		break;
+	case 0xd:
+		if (reg == R_A) {
+			return 0;
+		}
+
+		uop = U_ST16;
+		reg = R_D;
+		width = 2;
+		break;
+	case 0xe:
+	case 0xf:
+		uop = lo == 0xe ? U_LD16 : U_ST16;
+		reg = reg == R_A ? R_X : R_U;
+		width = 2;
+		break;
+	default:
+		return 0;
+	}
+
+	io = width == 2 ? IO_WORD : 0;
+
+	if (uop == U_ST8 || uop == U_ST16) {
+		if (!block_ea (cpu, b, d, io | IO_WR, extra)) {
+			return 0;
+		}
+	} else if (d->mode == E6809_AM_IMM8) {
+		block_emit (b, U_IMM, R_T, d->bytes[1]);
+	} else if (d->mode == E6809_AM_IMM16) {
+		block_emit (b, U_IMM, R_T, (d->bytes[1] << 8) | d->bytes[2]);
+	} else {
+		if (!block_ea (cpu, b, d, io | IO_RD, extra)) {
+			return 0;
+		}
+
+		block_emit (b, width == 2 ? U_RD16 : U_RD8, R_T, 0);
+	}
+
+	block_emit (b, uop, reg, 0);
+
+	return 1;
+}
+
+/* flag liveness, backwards from the end of the block where all flags are
+ * live. each micro-op only computes the flags it sets that are live.
+ */
+
+static void block_liveness (e6809_block_t *b)
+{
+	e6809_uop_t *u;
+	unsigned short  live, sets;
+	int i;
+
+	live = 0xff;
+
+	for (i = b->nuops - 1; i >= 0; i--) {
+		u = &b->uops[i];
+		sets = uop_sets[u->op];
+
+		if (u->op == U_LEA && u->aux == 0) {
+			sets = 0;
+		}
+
+		u->flags = sets & live;
+		live &= ~sets;
+
+		if (u->op == U_BCC) {
+			live |= FLAG_N | FLAG_Z | FLAG_V | FLAG_C;
+		}
+
+		if (u->op == U_IDX && u->io) {
+			/* side exit */
+
+			live = 0xff;
+		}
+	}
+}
+
+/* is the byte at address in memory that never changes? */
+
+static einline unsigned short  block_rom (e6809_t *cpu, unsigned short  address)
+{
+	return (cpu->dcache_page[address >> 8] & (DCACHE_EXEC | DCACHE_WATCH)) == DCACHE_EXEC;
+}
+
+static void block_translate (e6809_t *cpu, e6809_block_t *b, unsigned short  pc)
+{
+	dcache_t d;
+	unsigned short  n, i, insns, extra, cycles;
+
+	b->pc = pc;
+	b->used = 1;
+	b->nuops = 0;
+	b->dp = cpu->reg_dp;
+	b->dp_used = 0;
+	cycles = 0;
+
+	for (insns = 0; insns < BLOCK_MAXINSN; insns++) {
+		if (b->nuops + BLOCK_INSNUOPS + 1 > E6809_BLOCK_UOPS ||
+			!block_rom (cpu, pc) || !block_rom (cpu, pc + E6809_DCACHE_MAXLEN - 1)) {
+			break;
+		}
+
+		dcache_decode (cpu, &d, pc);
+
+		if (d.handler == ins_trap) {
+			break;
+		}
+
+		n = b->nuops;
+		extra = 0;
+
+		if (!block_insn (cpu, b, &d, &extra)) {
+			b->nuops = n;
+			break;
+		}
+
+		for (i = n; i < b->nuops; i++) {
+			b->uops[i].pc = pc;
+			b->uops[i].cycles = cycles;
+		}
+
+		b->last = d.cycles + extra;
+		cycles += b->last;
+		pc += d.len;
+
+		if ((d.bytes[0] >> 4) == 0x2) {
+			insns++;
+			break;
+		}
+	}
+
+	if (insns < BLOCK_MININSN) {
+		b->nuops = 0;
+		return;
+	}
+
+	if (b->nuops == 0 || b->uops[b->nuops - 1].op != U_BCC) {
+		block_emit (b, U_END, 0, pc);
+	}
+
+	b->cycles = cycles;
+	block_liveness (b);
+}
+
+/* the taken condition of a short branch, see inst_bra8 */
+
+static einline unsigned short  block_branch (unsigned short  cc, unsigned short  op)
+{
+	unsigned short  n, z, v, c, test;
+
+	n = (cc / FLAG_N) & 1;
+	z = (cc / FLAG_Z) & 1;
+	v = (cc / FLAG_V) & 1;
+	c = (cc / FLAG_C) & 1;
+
+	switch (op & 0xe) {
+	case 0x0: test = 0; break;
+	case 0x2: test = c | z; break;
+	case 0x4: test = c; break;
+	case 0x6: test = z; break;
+	case 0x8: test = v; break;
+	case 0xa: test = n; break;
+	case 0xc: test = n ^ v; break;
+	default:  test = z | (n ^ v); break;
+	}
+
+	return test == (op & 1);
+}
+
+/* the live flags of u from an alu operation */
+
+static einline unsigned short  uop_cc (const e6809_uop_t *u, unsigned short  cc,
+	unsigned short  kind, unsigned short  i0, unsigned short  i1, unsigned short  r)
+{
+	if (u->flags) {
+		cc = (cc & ~u->flags) | (cc_compute (kind, i0, i1, r) & u->flags);
+	}
+
+	return cc;
+}
+
+/* the live flags of u set to the given values */
+
+static einline unsigned short  uop_set (const e6809_uop_t *u, unsigned short  cc, unsigned short  value)
+{
+	return (cc & ~u->flags) | (value & u->flags);
+}
+
+static einline unsigned short  uop_get16 (const unsigned short  *r, unsigned short  reg)
+{
+	if (reg == R_D) {
+		return (r[R_A] << 8) | (r[R_B] & 0xff);
+	}
+
+	return r[reg];
+}
+
+static einline void uop_set16 (unsigned short  *r, unsigned short  reg, unsigned short  value)
+{
+	if (reg == R_D) {
+		r[R_A] = value >> 8;
+		r[R_B] = value;
+	} else {
+		r[reg] = value;
+	}
+}
+
+/* run block b and return the number of cycles it took */
+
+static unsigned int block_exec (e6809_t *cpu, const e6809_block_t *b)
+{
+	const e6809_uop_t *u;
+	unsigned short  r[R_COUNT];
+	unsigned short  cc, ea, i0, i1, x, base, pc;
+	unsigned int cycles;
+
+	r[R_X] = cpu->reg_x;
+	r[R_Y] = cpu->reg_y;
+	r[R_U] = cpu->reg_u;
+	r[R_S] = cpu->reg_s;
+	r[R_A] = cpu->reg_a;
+	r[R_B] = cpu->reg_b;
+	r[R_T] = 0;
+	cc = get_reg_cc (cpu);
+	ea = 0;
+
+	for (u = b->uops; ; u++) {
+		switch (u->op) {
+		case U_EA:
+			ea = u->arg;
+			break;
+		case U_IDX:
+			base = r[u->reg];
+
+			switch (u->aux) {
+			case E6809_IDX_INC:
+				ea = base;
+				base += u->arg;
+				break;
+			case E6809_IDX_DEC:
+				base -= u->arg;
+				ea = base;
+				break;
+			case E6809_IDX_A:
+				ea = base + sign_extend (r[R_A]);
+				break;
+			case E6809_IDX_B:
+				ea = base + sign_extend (r[R_B]);
+				break;
+			case E6809_IDX_D:
+				ea = base + uop_get16 (r, R_D);
+				break;
+			default:
+				ea = base + u->arg;
+				break;
+			}
+
+			if (u->io && block_io (cpu, ea, u->io)) {
+				/* leave before this instruction */
+
+				pc = u->pc;
+				cycles = u->cycles;
+				goto out;
+			}
+
+			r[u->reg] = base;
+			break;
+		case U_IMM:
+			r[R_T] = u->arg;
+			break;
+		case U_RD8:
+			r[R_T] = read8 (cpu, ea);
+			break;
+		case U_RD16:
+			r[R_T] = read16 (cpu, ea);
+			break;
+		case U_WR8:
+			write8 (cpu, ea, r[u->reg]);
+			break;
+		case U_ST8:
+			write8 (cpu, ea, r[u->reg]);
+			cc = uop_cc (u, cc, CC_TST8, 0, 0, r[u->reg]);
+			break;
+		case U_ST16:
+			x = uop_get16 (r, u->reg);
+			write16 (cpu, ea, x);
+			cc = uop_cc (u, cc, CC_TST16, 0, 0, x);
+			break;
+		case U_LD8:
+			r[u->reg] = r[R_T];
+			cc = uop_cc (u, cc, CC_TST8, 0, 0, r[R_T]);
+			break;
+		case U_LD16:
+			uop_set16 (r, u->reg, r[R_T]);
+			cc = uop_cc (u, cc, CC_TST16, 0, 0, uop_get16 (r, u->reg));
+			break;
+		case U_ADD8:
+			i0 = r[u->reg];
+			i1 = r[R_T];
+			r[u->reg] = i0 + i1;
+			cc = uop_cc (u, cc, CC_ADD8, i0, i1, r[u->reg]);
+			break;
+		case U_SUB8:
+		case U_CMP8:
+			i0 = r[u->reg];
+			i1 = ~r[R_T];
+			x = i0 + i1 + 1;
+			cc = uop_cc (u, cc, CC_SUB8, i0, i1, x);
+
+			if (u->op == U_SUB8) {
+				r[u->reg] = x;
+			}
+			break;
+		case U_AND8:
+		case U_BIT8:
+			x = r[u->reg] & r[R_T];
+			cc = uop_cc (u, cc, CC_TST8, 0, 0, x);
+
+			if (u->op == U_AND8) {
+				r[u->reg] = x;
+			}
+			break;
+		case U_EOR8:
+			r[u->reg] ^= r[R_T];
+			cc = uop_cc (u, cc, CC_TST8, 0, 0, r[u->reg]);
+			break;
+		case U_OR8:
+			r[u->reg] |= r[R_T];
+			cc = uop_cc (u, cc, CC_TST8, 0, 0, r[u->reg]);
+			break;
+		case U_ADD16:
+			i0 = uop_get16 (r, u->reg);
+			i1 = r[R_T];
+			x = i0 + i1;
+			uop_set16 (r, u->reg, x);
+			cc = uop_cc (u, cc, CC_ADD16, i0, i1, x);
+			break;
+		case U_SUB16:
+		case U_CMP16:
+			i0 = uop_get16 (r, u->reg);
+			i1 = ~r[R_T];
+			x = i0 + i1 + 1;
+			cc = uop_cc (u, cc, CC_SUB16, i0, i1, x);
+
+			if (u->op == U_SUB16) {
+				uop_set16 (r, u->reg, x);
+			}
+			break;
+		case U_NEG:
+			i1 = ~r[u->reg];
+			r[u->reg] = i1 + 1;
+			cc = uop_cc (u, cc, CC_SUB8, 0, i1, r[u->reg]);
+			break;
+		case U_COM:
+			x = ~r[u->reg];
+			r[u->reg] = x;
+			cc = uop_set (u, cc, test_n (x) * FLAG_N | test_z8 (x) * FLAG_Z | FLAG_C);
+			break;
+		case U_LSR:
+			x = r[u->reg];
+			r[u->reg] = (x >> 1) & 0x7f;
+			cc = uop_set (u, cc, test_z8 (r[u->reg]) * FLAG_Z | (x & 1) * FLAG_C);
+			break;
+		case U_ASR:
+			x = r[u->reg];
+			r[u->reg] = ((x >> 1) & 0x7f) | (x & 0x80);
+			cc = uop_set (u, cc, test_n (r[u->reg]) * FLAG_N |
+				test_z8 (r[u->reg]) * FLAG_Z | (x & 1) * FLAG_C);
+			break;
+		case U_ASL:
+			i0 = r[u->reg];
+			r[u->reg] = i0 + i0;
+			cc = uop_cc (u, cc, CC_ADD8, i0, i0, r[u->reg]);
+			break;
+		case U_DEC:
+			i0 = r[u->reg];
+			r[u->reg] = i0 + 0xff;
+			cc = uop_cc (u, cc, CC_ADD8, i0, 0xff, r[u->reg]);
+			break;
+		case U_INC:
+			i0 = r[u->reg];
+			r[u->reg] = i0 + 1;
+			cc = uop_cc (u, cc, CC_ADD8, i0, 1, r[u->reg]);
+			break;
+		case U_TST:
+			cc = uop_cc (u, cc, CC_TST8, 0, 0, r[u->reg]);
+			break;
+		case U_CLR:
+			r[u->reg] = 0;
+			cc = uop_set (u, cc, FLAG_Z);
+			break;
+		case U_LEA:
+			r[u->reg] = ea;
+			cc = uop_set (u, cc, test_z16 (ea) * FLAG_Z);
+			break;
+		case U_BCC:
+			pc = block_branch (cc, u->aux) ? u->arg : u->pc + 2;
+			cycles = b->cycles;
+			goto out;
+		default:
+			pc = u->arg;
+			cycles = b->cycles;
+			goto out;
+		}
+	}
+
+out:
+	cpu->reg_x = r[R_X];
+	cpu->reg_y = r[R_Y];
+	cpu->reg_u = r[R_U];
+	cpu->reg_s = r[R_S];
+	cpu->reg_a = r[R_A];
+	cpu->reg_b = r[R_B];
+	set_reg_cc (cpu, cc);
+	cpu->reg_pc = pc;
+
+	return cycles;
+}
+
+/* run the block at pc, translating it first if needed. returns 0 if the
+ * instruction at pc has to go to the interpreter.
+ */
+
+static einline unsigned int block_run (e6809_t *cpu)
+{
+	e6809_block_t *b;
+
+	b = &cpu->blocks[cpu->reg_pc & (E6809_BLOCKS - 1)];
+
+	if (b->used == 0 || b->pc != cpu->reg_pc || (b->dp_used && b->dp != (cpu->reg_dp & 0xff))) {
+		block_translate (cpu, b, cpu->reg_pc);
+	}
+
+	if (b->nuops == 0 || cpu->run_cycles + b->cycles - b->last >= cpu->run_limit) {
+		return 0;
+	}
+
+	return block_exec (cpu, b);
+}
+
+#ifdef E6809_RECOMPILED
+
+/* statically recompiled code. tools/e6809rec.c turns the code it finds
+ * in a bios and a cartridge into one c function per basic block, which is
+ * included here so that it can inline the handlers. a block runs its
+ * instructions like e6809_run would, but without looking them up: it
+ * stops early on e6809_sync or when the budget is used up, and the last
+ * instruction of a block is the only one that can jump. the code is only
+ * used while the memory map shows exactly the roms it was made from.
+ */
+
+typedef void (*rec_block_t) (e6809_t *cpu);
+
+typedef struct {
+	unsigned short start;
+	unsigned int len;
+	const unsigned char *bytes;
+} rec_image_t;
+
+#define REC_INSN(bytes, pc, oplen, cycles, handler) \
+	cpu->fetch = (bytes) + (oplen); \
+	cpu->reg_pc = (pc) + (oplen); \
+	done = (cycles) + handler (cpu); \
+	cpu->run_cycles += done
+
+#define REC_NEXT() \
+	if (cpu->run_sync || cpu->run_cycles >= cpu->run_limit) { \
+		return; \
+	}
+
+#include E6809_RECOMPILED
+
+static void rec_check (e6809_t *cpu)
+{
+	const rec_image_t *im;
+	unsigned i;
+
+	cpu->recompiled = 0;
+
+	for (im = rec_images; im->bytes != NULL; im++) {
+		for (i = 0; i < im->len; i++) {
+			if (!block_rom (cpu, im->start + i) ||
+				read8 (cpu, im->start + i) != im->bytes[i]) {
+				return;
+			}
+		}
+	}
+
+	cpu->recompiled = 1;
+}
+
+/* run the recompiled block at pc. returns 0 if there is none. */
+
+static einline unsigned int rec_run (e6809_t *cpu)
+{
+	const rec_block_t *page;
+	int start, done;
+
+	page = rec_pages[cpu->reg_pc >> 8];
+
+	if (page == NULL || page[cpu->reg_pc & 0xff] == NULL ||
+		(cpu->trap_page[cpu->reg_pc >> 8] && trap_find (cpu, cpu->reg_pc) < cpu->traps)) {
+		return 0;
+	}
+
+	start = cpu->run_cycles;
+	page[cpu->reg_pc & 0xff] (cpu);
+	done = cpu->run_cycles - start;
+	cpu->run_cycles = start;
+
+	return done;
+}
+
+#endif
+
+#ifdef E6809_THREADED
+
+/* threaded code version of the e6809_run fast path. every op code has a
+ * label of its own, with its handler and a copy of the dispatch code that
+ * ends in a computed goto straight to the next handler. instead of one
+ * shared indirect call the branch predictor gets one indirect jump per op
+ * code, and what comes after an instruction is very predictable. the
+ * handlers are the same as in the plain interpreter and get inlined into
+ * their labels. the dispatch state lives in locals, the 6809 registers
+ * stay in the e6809_t since every memory access may call an i/o handler
+ * that reads them. needs gcc or clang.
+ */
+
+#ifndef __GNUC__
+#error E6809_THREADED needs computed goto (gcc or clang)
+#endif
+
+#ifdef E6809_PROFILE
+#define THREAD_PROFILE()	profile_count (cpu, e, done)
+#else
+#define THREAD_PROFILE()
+#endif
+
+/* to the next instruction, or out if the run is over */
+
+#ifdef E6809_PROFILE
+#define THREAD_BLOCK()
+#else
+#define THREAD_BLOCK() \
+	if (cpu->translate || cpu->recompiled) { \
+		goto block; \
+	}
+#endif
+
+#define THREAD_DISPATCH() \
+	if (cpu->run_cycles >= cycles || cpu->irq_status != IRQ_NORMAL) { \
+		goto out; \
+	} \
+ \
+	THREAD_BLOCK () \
+	THREAD_FETCH ()
+
+#define THREAD_FETCH() \
+	pc = cpu->reg_pc; \
+	e = dcache_fetch (cpu, pc); \
+	cpu->fetch = e->bytes + e->oplen; \
+	cpu->reg_pc += e->oplen; \
+	goto *threads[e->thread];
+
+#define THREAD(label, handler) \
+label: \
+	done = e->cycles + handler (cpu); \
+	THREAD_PROFILE (); \
+	cpu->run_cycles += done; \
+ \
+	if (cpu->run_sync) { \
+		goto out; \
+	} \
+ \
+	if ((unsigned short) (pc - cpu->reg_pc) <= IDLE_MAXLEN) { \
+		goto idle; \
+	} \
+ \
+	THREAD_DISPATCH ()
+
+static void run_threaded (e6809_t *cpu, int cycles)
+{
+	static void *const threads[] = {
+		/* page 0, 1 and 2 */
+
+		&&t_0x00, &&t_call, &&t_call, &&t_0x03, &&t_0x04, &&t_call, &&t_0x06, &&t_0x07, &&t_0x08, &&t_0x09, &&t_0x0a, &&t_call, &&t_0x0c, &&t_0x0d, &&t_0x0e, &&t_0x0f,
+		&&t_call, &&t_call, &&t_0x12, &&t_0x13, &&t_call, &&t_call, &&t_0x16, &&t_0x17, &&t_call, &&t_0x19, &&t_0x1a, &&t_call, &&t_0x1c, &&t_0x1d, &&t_0x1e, &&t_0x1f,
+		&&t_0x20, &&t_0x21, &&t_0x22, &&t_0x23, &&t_0x24, &&t_0x25, &&t_0x26, &&t_0x27, &&t_0x28, &&t_0x29, &&t_0x2a, &&t_0x2b, &&t_0x2c, &&t_0x2d, &&t_0x2e, &&t_0x2f,
+		&&t_0x30, &&t_0x31, &&t_0x32, &&t_0x33, &&t_0x34, &&t_0x35, &&t_0x36, &&t_0x37, &&t_call, &&t_0x39, &&t_0x3a, &&t_0x3b, &&t_0x3c, &&t_0x3d, &&t_call, &&t_0x3f,
+		&&t_0x40, &&t_call, &&t_call, &&t_0x43, &&t_0x44, &&t_call, &&t_0x46, &&t_0x47, &&t_0x48, &&t_0x49, &&t_0x4a, &&t_call, &&t_0x4c, &&t_0x4d, &&t_call, &&t_0x4f,
+		&&t_0x50, &&t_call, &&t_call, &&t_0x53, &&t_0x54, &&t_call, &&t_0x56, &&t_0x57, &&t_0x58, &&t_0x59, &&t_0x5a, &&t_call, &&t_0x5c, &&t_0x5d, &&t_call, &&t_0x5f,
+		&&t_0x60, &&t_call, &&t_call, &&t_0x63, &&t_0x64, &&t_call, &&t_0x66, &&t_0x67, &&t_0x68, &&t_0x69, &&t_0x6a, &&t_call, &&t_0x6c, &&t_0x6d, &&t_0x6e, &&t_0x6f,
+		&&t_0x70, &&t_call, &&t_call, &&t_0x73, &&t_0x74, &&t_call, &&t_0x76, &&t_0x77, &&t_0x78, &&t_0x79, &&t_0x7a, &&t_call, &&t_0x7c, &&t_0x7d, &&t_0x7e, &&t_0x7f,
+		&&t_0x80, &&t_0x81, &&t_0x82, &&t_0x83, &&t_0x84, &&t_0x85, &&t_0x86, &&t_call, &&t_0x88, &&t_0x89, &&t_0x8a, &&t_0x8b, &&t_0x8c, &&t_0x8d, &&t_0x8e, &&t_call,
+		&&t_0x90, &&t_0x91, &&t_0x92, &&t_0x93, &&t_0x94, &&t_0x95, &&t_0x96, &&t_0x97, &&t_0x98, &&t_0x99, &&t_0x9a, &&t_0x9b, &&t_0x9c, &&t_0x9d, &&t_0x9e, &&t_0x9f,
+		&&t_0xa0, &&t_0xa1, &&t_0xa2, &&t_0xa3, &&t_0xa4, &&t_0xa5, &&t_0xa6, &&t_0xa7, &&t_0xa8, &&t_0xa9, &&t_0xaa, &&t_0xab, &&t_0xac, &&t_0xad, &&t_0xae, &&t_0xaf,
+		&&t_0xb0, &&t_0xb1, &&t_0xb2, &&t_0xb3, &&t_0xb4, &&t_0xb5, &&t_0xb6, &&t_0xb7, &&t_0xb8, &&t_0xb9, &&t_0xba, &&t_0xbb, &&t_0xbc, &&t_0xbd, &&t_0xbe, &&t_0xbf,
+		&&t_0xc0, &&t_0xc1, &&t_0xc2, &&t_0xc3, &&t_0xc4, &&t_0xc5, &&t_0xc6, &&t_call, &&t_0xc8, &&t_0xc9, &&t_0xca, &&t_0xcb, &&t_0xcc, &&t_call, &&t_0xce, &&t_call,
+		&&t_0xd0, &&t_0xd1, &&t_0xd2, &&t_0xd3, &&t_0xd4, &&t_0xd5, &&t_0xd6, &&t_0xd7, &&t_0xd8, &&t_0xd9, &&t_0xda, &&t_0xdb, &&t_0xdc, &&t_0xdd, &&t_0xde, &&t_0xdf,
+		&&t_0xe0, &&t_0xe1, &&t_0xe2, &&t_0xe3, &&t_0xe4, &&t_0xe5, &&t_0xe6, &&t_0xe7, &&t_0xe8, &&t_0xe9, &&t_0xea, &&t_0xeb, &&t_0xec, &&t_0xed, &&t_0xee, &&t_0xef,
+		&&t_0xf0, &&t_0xf1, &&t_0xf2, &&t_0xf3, &&t_0xf4, &&t_0xf5, &&t_0xf6, &&t_0xf7, &&t_0xf8, &&t_0xf9, &&t_0xfa, &&t_0xfb, &&t_0xfc, &&t_0xfd, &&t_0xfe, &&t_0xff,
+
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_0x10_0x20, &&t_0x10_0x21, &&t_0x10_0x22, &&t_0x10_0x23, &&t_0x10_0x24, &&t_0x10_0x25, &&t_0x10_0x26, &&t_0x10_0x27, &&t_0x10_0x28, &&t_0x10_0x29, &&t_0x10_0x2a, &&t_0x10_0x2b, &&t_0x10_0x2c, &&t_0x10_0x2d, &&t_0x10_0x2e, &&t_0x10_0x2f,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0x3f,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_0x10_0x83, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0x8c, &&t_call, &&t_0x10_0x8e, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_0x10_0x93, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0x9c, &&t_call, &&t_0x10_0x9e, &&t_0x10_0x9f,
+		&&t_call, &&t_call, &&t_call, &&t_0x10_0xa3, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0xac, &&t_call, &&t_0x10_0xae, &&t_0x10_0xaf,
+		&&t_call, &&t_call, &&t_call, &&t_0x10_0xb3, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0xbc, &&t_call, &&t_0x10_0xbe, &&t_0x10_0xbf,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0xce, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0xde, &&t_0x10_0xdf,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0xee, &&t_0x10_0xef,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x10_0xfe, &&t_0x10_0xff,
+
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x11_0x3f,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_0x11_0x83, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x11_0x8c, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_0x11_0x93, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x11_0x9c, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_0x11_0xa3, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x11_0xac, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_0x11_0xb3, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_0x11_0xbc, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+		&&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call, &&t_call,
+
+		/* fused pairs, in the order of fusions[] */
+
+		&&t_0x5a_0x26, &&t_0x4a_0x26, &&t_0x12_0x5a, &&t_0x86_0x12, &&t_0xd5_0x27, &&t_0x5c_0x2a, &&t_0xa6_0x2a,
+		&&t_0xa6_0x2f, &&t_0x81_0x23, &&t_0x81_0x26, &&t_0xc1_0x26, &&t_0x86_0x97, &&t_0xc6_0xd7, &&t_0xa6_0x97,
+		&&t_0xec_0x97, &&t_0x97_0xa6, &&t_0x97_0x0f, &&t_0x97_0xd7, &&t_0xd7_0x97, &&t_0x0c_0xd7, &&t_0x12_0x97,
+
+		/* trapped instructions */
+
+		&&t_call
+	};
+
+	const dcache_t *e;
+	idle_t idle = { 0 };
+	unsigned short  pc;
+	unsigned int done;
+
+	THREAD_DISPATCH ()
+
+	/* the op codes without a handler of their own: undefined ones */
+
+	THREAD (t_call, e->handler)
+
+	THREAD (t_0x00, ins_0x00)
+	THREAD (t_0x03, ins_0x03)
+	THREAD (t_0x04, ins_0x04)
+	THREAD (t_0x06, ins_0x06)
+	THREAD (t_0x07, ins_0x07)
+	THREAD (t_0x08, ins_0x08)
+	THREAD (t_0x09, ins_0x09)
+	THREAD (t_0x0a, ins_0x0a)
+	THREAD (t_0x0c, ins_0x0c)
+	THREAD (t_0x0d, ins_0x0d)
+	THREAD (t_0x0e, ins_0x0e)
+	THREAD (t_0x0f, ins_0x0f)
+	THREAD (t_0x12, ins_0x12)
+	THREAD (t_0x13, ins_0x13)
+	THREAD (t_0x16, ins_0x16)
+	THREAD (t_0x17, ins_0x17)
+	THREAD (t_0x19, ins_0x19)
+	THREAD (t_0x1a, ins_0x1a)
+	THREAD (t_0x1c, ins_0x1c)
+	THREAD (t_0x1d, ins_0x1d)
+	THREAD (t_0x1e, ins_0x1e)
+	THREAD (t_0x1f, ins_0x1f)
+	THREAD (t_0x20, ins_0x20)
+	THREAD (t_0x21, ins_0x21)
+	THREAD (t_0x22, ins_0x22)
+	THREAD (t_0x23, ins_0x23)
+	THREAD (t_0x24, ins_0x24)
+	THREAD (t_0x25, ins_0x25)
+	THREAD (t_0x26, ins_0x26)
+	THREAD (t_0x27, ins_0x27)
+	THREAD (t_0x28, ins_0x28)
+	THREAD (t_0x29, ins_0x29)
+	THREAD (t_0x2a, ins_0x2a)
+	THREAD (t_0x2b, ins_0x2b)
+	THREAD (t_0x2c, ins_0x2c)
+	THREAD (t_0x2d, ins_0x2d)
+	THREAD (t_0x2e, ins_0x2e)
+	THREAD (t_0x2f, ins_0x2f)
+	THREAD (t_0x30, ins_0x30)
+	THREAD (t_0x31, ins_0x31)
+	THREAD (t_0x32, ins_0x32)
+	THREAD (t_0x33, ins_0x33)
+	THREAD (t_0x34, ins_0x34)
+	THREAD (t_0x35, ins_0x35)
+	THREAD (t_0x36, ins_0x36)
+	THREAD (t_0x37, ins_0x37)
+	THREAD (t_0x39, ins_0x39)
+	THREAD (t_0x3a, ins_0x3a)
+	THREAD (t_0x3b, ins_0x3b)
+	THREAD (t_0x3c, ins_0x3c)
+	THREAD (t_0x3d, ins_0x3d)
+	THREAD (t_0x3f, ins_0x3f)
+	THREAD (t_0x40, ins_0x40)
+	THREAD (t_0x43, ins_0x43)
+	THREAD (t_0x44, ins_0x44)
+	THREAD (t_0x46, ins_0x46)
+	THREAD (t_0x47, ins_0x47)
+	THREAD (t_0x48, ins_0x48)
+	THREAD (t_0x49, ins_0x49)
+	THREAD (t_0x4a, ins_0x4a)
+	THREAD (t_0x4c, ins_0x4c)
+	THREAD (t_0x4d, ins_0x4d)
+	THREAD (t_0x4f, ins_0x4f)
+	THREAD (t_0x50, ins_0x50)
+	THREAD (t_0x53, ins_0x53)
+	THREAD (t_0x54, ins_0x54)
+	THREAD (t_0x56, ins_0x56)
+	THREAD (t_0x57, ins_0x57)
+	THREAD (t_0x58, ins_0x58)
+	THREAD (t_0x59, ins_0x59)
+	THREAD (t_0x5a, ins_0x5a)
+	THREAD (t_0x5c, ins_0x5c)
+	THREAD (t_0x5d, ins_0x5d)
+	THREAD (t_0x5f, ins_0x5f)
+	THREAD (t_0x60, ins_0x60)
+	THREAD (t_0x63, ins_0x63)
+	THREAD (t_0x64, ins_0x64)
+	THREAD (t_0x66, ins_0x66)
+	THREAD (t_0x67, ins_0x67)
+	THREAD (t_0x68, ins_0x68)
+	THREAD (t_0x69, ins_0x69)
+	THREAD (t_0x6a, ins_0x6a)
+	THREAD (t_0x6c, ins_0x6c)
+	THREAD (t_0x6d, ins_0x6d)
+	THREAD (t_0x6e, ins_0x6e)
+	THREAD (t_0x6f, ins_0x6f)
+	THREAD (t_0x70, ins_0x70)
+	THREAD (t_0x73, ins_0x73)
+	THREAD (t_0x74, ins_0x74)
+	THREAD (t_0x76, ins_0x76)
+	THREAD (t_0x77, ins_0x77)
+	THREAD (t_0x78, ins_0x78)
+	THREAD (t_0x79, ins_0x79)
+	THREAD (t_0x7a, ins_0x7a)
+	THREAD (t_0x7c, ins_0x7c)
+	THREAD (t_0x7d, ins_0x7d)
+	THREAD (t_0x7e, ins_0x7e)
+	THREAD (t_0x7f, ins_0x7f)
+	THREAD (t_0x80, ins_0x80)
+	THREAD (t_0x81, ins_0x81)
+	THREAD (t_0x82, ins_0x82)
+	THREAD (t_0x83, ins_0x83)
+	THREAD (t_0x84, ins_0x84)
+	THREAD (t_0x85, ins_0x85)
+	THREAD (t_0x86, ins_0x86)
+	THREAD (t_0x88, ins_0x88)
+	THREAD (t_0x89, ins_0x89)
+	THREAD (t_0x8a, ins_0x8a)
+	THREAD (t_0x8b, ins_0x8b)
+	THREAD (t_0x8c, ins_0x8c)
+	THREAD (t_0x8d, ins_0x8d)
+	THREAD (t_0x8e, ins_0x8e)
+	THREAD (t_0x90, ins_0x90)
+	THREAD (t_0x91, ins_0x91)
+	THREAD (t_0x92, ins_0x92)
+	THREAD (t_0x93, ins_0x93)
+	THREAD (t_0x94, ins_0x94)
+	THREAD (t_0x95, ins_0x95)
+	THREAD (t_0x96, ins_0x96)
+	THREAD (t_0x97, ins_0x97)
+	THREAD (t_0x98, ins_0x98)
+	THREAD (t_0x99, ins_0x99)
+	THREAD (t_0x9a, ins_0x9a)
+	THREAD (t_0x9b, ins_0x9b)
+	THREAD (t_0x9c, ins_0x9c)
+	THREAD (t_0x9d, ins_0x9d)
+	THREAD (t_0x9e, ins_0x9e)
+	THREAD (t_0x9f, ins_0x9f)
+	THREAD (t_0xa0, ins_0xa0)
+	THREAD (t_0xa1, ins_0xa1)
+	THREAD (t_0xa2, ins_0xa2)
+	THREAD (t_0xa3, ins_0xa3)
+	THREAD (t_0xa4, ins_0xa4)
+	THREAD (t_0xa5, ins_0xa5)
+	THREAD (t_0xa6, ins_0xa6)
+	THREAD (t_0xa7, ins_0xa7)
+	THREAD (t_0xa8, ins_0xa8)
+	THREAD (t_0xa9, ins_0xa9)
+	THREAD (t_0xaa, ins_0xaa)
+	THREAD (t_0xab, ins_0xab)
+	THREAD (t_0xac, ins_0xac)
+	THREAD (t_0xad, ins_0xad)
+	THREAD (t_0xae, ins_0xae)
+	THREAD (t_0xaf, ins_0xaf)
+	THREAD (t_0xb0, ins_0xb0)
+	THREAD (t_0xb1, ins_0xb1)
+	THREAD (t_0xb2, ins_0xb2)
+	THREAD (t_0xb3, ins_0xb3)
+	THREAD (t_0xb4, ins_0xb4)
+	THREAD (t_0xb5, ins_0xb5)
+	THREAD (t_0xb6, ins_0xb6)
+	THREAD (t_0xb7, ins_0xb7)
+	THREAD (t_0xb8, ins_0xb8)
+	THREAD (t_0xb9, ins_0xb9)
+	THREAD (t_0xba, ins_0xba)
+	THREAD (t_0xbb, ins_0xbb)
+	THREAD (t_0xbc, ins_0xbc)
+	THREAD (t_0xbd, ins_0xbd)
+	THREAD (t_0xbe, ins_0xbe)
+	THREAD (t_0xbf, ins_0xbf)
+	THREAD (t_0xc0, ins_0xc0)
+	THREAD (t_0xc1, ins_0xc1)
+	THREAD (t_0xc2, ins_0xc2)
+	THREAD (t_0xc3, ins_0xc3)
+	THREAD (t_0xc4, ins_0xc4)
+	THREAD (t_0xc5, ins_0xc5)
+	THREAD (t_0xc6, ins_0xc6)
+	THREAD (t_0xc8, ins_0xc8)
+	THREAD (t_0xc9, ins_0xc9)
+	THREAD (t_0xca, ins_0xca)
+	THREAD (t_0xcb, ins_0xcb)
+	THREAD (t_0xcc, ins_0xcc)
+	THREAD (t_0xce, ins_0xce)
+	THREAD (t_0xd0, ins_0xd0)
+	THREAD (t_0xd1, ins_0xd1)
+	THREAD (t_0xd2, ins_0xd2)
+	THREAD (t_0xd3, ins_0xd3)
+	THREAD (t_0xd4, ins_0xd4)
+	THREAD (t_0xd5, ins_0xd5)
+	THREAD (t_0xd6, ins_0xd6)
+	THREAD (t_0xd7, ins_0xd7)
+	THREAD (t_0xd8, ins_0xd8)
+	THREAD (t_0xd9, ins_0xd9)
+	THREAD (t_0xda, ins_0xda)
+	THREAD (t_0xdb, ins_0xdb)
+	THREAD (t_0xdc, ins_0xdc)
+	THREAD (t_0xdd, ins_0xdd)
+	THREAD (t_0xde, ins_0xde)
+	THREAD (t_0xdf, ins_0xdf)
+	THREAD (t_0xe0, ins_0xe0)
+	THREAD (t_0xe1, ins_0xe1)
+	THREAD (t_0xe2, ins_0xe2)
+	THREAD (t_0xe3, ins_0xe3)
+	THREAD (t_0xe4, ins_0xe4)
+	THREAD (t_0xe5, ins_0xe5)
+	THREAD (t_0xe6, ins_0xe6)
+	THREAD (t_0xe7, ins_0xe7)
+	THREAD (t_0xe8, ins_0xe8)
+	THREAD (t_0xe9, ins_0xe9)
+	THREAD (t_0xea, ins_0xea)
+	THREAD (t_0xeb, ins_0xeb)
+	THREAD (t_0xec, ins_0xec)
+	THREAD (t_0xed, ins_0xed)
+	THREAD (t_0xee, ins_0xee)
+	THREAD (t_0xef, ins_0xef)
+	THREAD (t_0xf0, ins_0xf0)
+	THREAD (t_0xf1, ins_0xf1)
+	THREAD (t_0xf2, ins_0xf2)
+	THREAD (t_0xf3, ins_0xf3)
+	THREAD (t_0xf4, ins_0xf4)
+	THREAD (t_0xf5, ins_0xf5)
+	THREAD (t_0xf6, ins_0xf6)
+	THREAD (t_0xf7, ins_0xf7)
+	THREAD (t_0xf8, ins_0xf8)
+	THREAD (t_0xf9, ins_0xf9)
+	THREAD (t_0xfa, ins_0xfa)
+	THREAD (t_0xfb, ins_0xfb)
+	THREAD (t_0xfc, ins_0xfc)
+	THREAD (t_0xfd, ins_0xfd)
+	THREAD (t_0xfe, ins_0xfe)
+	THREAD (t_0xff, ins_0xff)
+	THREAD (t_0x10_0x20, ins_0x10_0x20)
+	THREAD (t_0x10_0x21, ins_0x10_0x21)
+	THREAD (t_0x10_0x22, ins_0x10_0x22)
+	THREAD (t_0x10_0x23, ins_0x10_0x23)
+	THREAD (t_0x10_0x24, ins_0x10_0x24)
+	THREAD (t_0x10_0x25, ins_0x10_0x25)
+	THREAD (t_0x10_0x26, ins_0x10_0x26)
+	THREAD (t_0x10_0x27, ins_0x10_0x27)
+	THREAD (t_0x10_0x28, ins_0x10_0x28)
+	THREAD (t_0x10_0x29, ins_0x10_0x29)
+	THREAD (t_0x10_0x2a, ins_0x10_0x2a)
+	THREAD (t_0x10_0x2b, ins_0x10_0x2b)
+	THREAD (t_0x10_0x2c, ins_0x10_0x2c)
+	THREAD (t_0x10_0x2d, ins_0x10_0x2d)
+	THREAD (t_0x10_0x2e, ins_0x10_0x2e)
+	THREAD (t_0x10_0x2f, ins_0x10_0x2f)
+	THREAD (t_0x10_0x3f, ins_0x10_0x3f)
+	THREAD (t_0x10_0x83, ins_0x10_0x83)
+	THREAD (t_0x10_0x8c, ins_0x10_0x8c)
+	THREAD (t_0x10_0x8e, ins_0x10_0x8e)
+	THREAD (t_0x10_0x93, ins_0x10_0x93)
+	THREAD (t_0x10_0x9c, ins_0x10_0x9c)
+	THREAD (t_0x10_0x9e, ins_0x10_0x9e)
+	THREAD (t_0x10_0x9f, ins_0x10_0x9f)
+	THREAD (t_0x10_0xa3, ins_0x10_0xa3)
+	THREAD (t_0x10_0xac, ins_0x10_0xac)
+	THREAD (t_0x10_0xae, ins_0x10_0xae)
+	THREAD (t_0x10_0xaf, ins_0x10_0xaf)
+	THREAD (t_0x10_0xb3, ins_0x10_0xb3)
+	THREAD (t_0x10_0xbc, ins_0x10_0xbc)
+	THREAD (t_0x10_0xbe, ins_0x10_0xbe)
+	THREAD (t_0x10_0xbf, ins_0x10_0xbf)
+	THREAD (t_0x10_0xce, ins_0x10_0xce)
+	THREAD (t_0x10_0xde, ins_0x10_0xde)
+	THREAD (t_0x10_0xdf, ins_0x10_0xdf)
+	THREAD (t_0x10_0xee, ins_0x10_0xee)
+	THREAD (t_0x10_0xef, ins_0x10_0xef)
+	THREAD (t_0x10_0xfe, ins_0x10_0xfe)
+	THREAD (t_0x10_0xff, ins_0x10_0xff)
+	THREAD (t_0x11_0x3f, ins_0x11_0x3f)
+	THREAD (t_0x11_0x83, ins_0x11_0x83)
+	THREAD (t_0x11_0x8c, ins_0x11_0x8c)
+	THREAD (t_0x11_0x93, ins_0x11_0x93)
+	THREAD (t_0x11_0x9c, ins_0x11_0x9c)
+	THREAD (t_0x11_0xa3, ins_0x11_0xa3)
+	THREAD (t_0x11_0xac, ins_0x11_0xac)
+	THREAD (t_0x11_0xb3, ins_0x11_0xb3)
+	THREAD (t_0x11_0xbc, ins_0x11_0xbc)
+
+	THREAD (t_0x5a_0x26, fuse_0x5a_0x26)
+	THREAD (t_0x4a_0x26, fuse_0x4a_0x26)
+	THREAD (t_0x12_0x5a, fuse_0x12_0x5a)
+	THREAD (t_0x86_0x12, fuse_0x86_0x12)
+	THREAD (t_0xd5_0x27, fuse_0xd5_0x27)
+	THREAD (t_0x5c_0x2a, fuse_0x5c_0x2a)
+	THREAD (t_0xa6_0x2a, fuse_0xa6_0x2a)
+	THREAD (t_0xa6_0x2f, fuse_0xa6_0x2f)
+	THREAD (t_0x81_0x23, fuse_0x81_0x23)
+	THREAD (t_0x81_0x26, fuse_0x81_0x26)
+	THREAD (t_0xc1_0x26, fuse_0xc1_0x26)
+	THREAD (t_0x86_0x97, fuse_0x86_0x97)
+	THREAD (t_0xc6_0xd7, fuse_0xc6_0xd7)
+	THREAD (t_0xa6_0x97, fuse_0xa6_0x97)
+	THREAD (t_0xec_0x97, fuse_0xec_0x97)
+	THREAD (t_0x97_0xa6, fuse_0x97_0xa6)
+	THREAD (t_0x97_0x0f, fuse_0x97_0x0f)
+	THREAD (t_0x97_0xd7, fuse_0x97_0xd7)
+	THREAD (t_0xd7_0x97, fuse_0xd7_0x97)
+	THREAD (t_0x0c_0xd7, fuse_0x0c_0xd7)
+	THREAD (t_0x12_0x97, fuse_0x12_0x97)
+
+idle:
+	idle_check (cpu, &idle, cycles);
+	THREAD_DISPATCH ()
+
+#ifndef E6809_PROFILE
+block:
+	/* a recompiled or translated block, or the interpreter if there is none */
+
+	pc = cpu->reg_pc;
+	done = 0;
+
+#ifdef E6809_RECOMPILED
+	if (cpu->recompiled) {
+		done = rec_run (cpu);
+	}
+#endif
+
+	if (done == 0 && cpu->translate) {
+		done = block_run (cpu);
+	}
+
+	if (done == 0) {
+		THREAD_FETCH ()
+	}
+
+	cpu->run_cycles += done;
+
+	if ((unsigned short) (pc - cpu->reg_pc) <= IDLE_MAXLEN) {
+		goto idle;
+	}
+
+	THREAD_DISPATCH ()
+#endif
+
+out:
+	if (cpu->run_sync == 0 && cpu->run_cycles < cycles) {
+		/* sync/cwai with no interrupt coming during this run */
+
+		cpu->run_cycles = cycles;
+	}
+}
+
+#endif
+
+/* run for at least the given number of cycles with constant interrupt
+ * lines. returns early if a peripheral calls e6809_sync, for example
+ * because it changed one of the interrupt lines.
+ */
+
+int e6809_run (e6809_t *cpu, int cycles, unsigned short  irq_i, unsigned short  irq_f)
+{
+#ifndef E6809_THREADED
+	idle_t idle = { 0 };
+	unsigned short  pc;
+#endif
+	int done;
+
+	cpu->run_cycles = 0;
+	cpu->run_sync = 0;
+
+	if (irq_i || irq_f) {
+		/* an interrupt is pending. the masks have to be checked before
+		 * every instruction since the program may enable it at any time.
+		 */
+
+		while (cpu->run_cycles < cycles && cpu->run_sync == 0) {
+			cpu->run_cycles += e6809_sstep (cpu, irq_i, irq_f);
+		}
+	} else {
+		cpu->run_wrote = 1;
+		cpu->run_limit = cycles;
+
+#ifdef E6809_THREADED
+		run_threaded (cpu, cycles);
+#else
+		while (cpu->run_cycles < cycles) {
+			if (cpu->irq_status != IRQ_NORMAL) {
+				/* sync/cwai with no interrupt coming during this run */
+
+				cpu->run_cycles = cycles;
+				break;
+			}
+
+			pc = cpu->reg_pc;
+
+			/* a fused pair books the cycles of its first half itself */
+
+			done = 0;
+
+#ifndef E6809_PROFILE
+			/* profiles are taken on the plain instruction stream */
+
+#ifdef E6809_RECOMPILED
+			if (cpu->recompiled) {
+				done = rec_run (cpu);
+			}
+#endif
+
+			if (done == 0 && cpu->translate) {
+				done = block_run (cpu);
+			}
+#endif
+
+			if (done == 0) {
+				done = e6809_exec (cpu);
+			}
+
+			cpu->run_cycles += done;
+
+			if (cpu->run_sync) {
+				break;
+			}
+
+			if ((unsigned short) (pc - cpu->reg_pc) <= IDLE_MAXLEN) {
+				idle_check (cpu, &idle, cycles);
+			}
+		}
+#endif
+	}
+
+	done = cpu->run_cycles;
+	cpu->run_cycles = 0;
+	cpu->run_limit = 0;
+
+	return done;
+}
+
+void e6809_sync (e6809_t *cpu)
+{
+	cpu->run_sync = 1;
+}
+
+int e6809_elapsed (e6809_t *cpu)
+{
+	return cpu->run_cycles;
+}
+
+void e6809_volatile (e6809_t *cpu)
+{
+	cpu->run_volatile = 1;
+}
+
+void e6809_fuse (e6809_t *cpu, unsigned on)
+{
+	cpu->fuse = on;
+	dcache_flush (cpu);
+}
+
+void e6809_translate (e6809_t *cpu, unsigned on)
+{
+	cpu->translate = on;
+	dcache_flush (cpu);
+}
+
+void e6809_trap (e6809_t *cpu, unsigned short address, e6809_trap_t trap)
+{
+	unsigned i;
+
+	i = trap_find (cpu, address);
+
+	if (i < cpu->traps) {
+		cpu->traps--;
+		cpu->trap_pc[i] = cpu->trap_pc[cpu->traps];
+		cpu->trap_fn[i] = cpu->trap_fn[cpu->traps];
+		cpu->trap_page[address >> 8]--;
+	}
+
+	if (trap != NULL && cpu->traps < E6809_TRAPS) {
+		cpu->trap_pc[cpu->traps] = address;
+		cpu->trap_fn[cpu->traps] = trap;
+		cpu->traps++;
+		cpu->trap_page[address >> 8]++;
+	}
+
+	dcache_flush (cpu);
+}
+
+unsigned e6809_get_reg (e6809_t *cpu, unsigned reg)
+{
+	switch (reg) {
+	case E6809_REG_X:
+		return cpu->reg_x & 0xffff;
+	case E6809_REG_Y:
+		return cpu->reg_y & 0xffff;
+	case E6809_REG_U:
+		return cpu->reg_u & 0xffff;
+	case E6809_REG_S:
+		return cpu->reg_s & 0xffff;
+	case E6809_REG_PC:
+		return cpu->reg_pc & 0xffff;
+	case E6809_REG_A:
+		return cpu->reg_a & 0xff;
+	case E6809_REG_B:
+		return cpu->reg_b & 0xff;
+	case E6809_REG_D:
+		return get_reg_d (cpu) & 0xffff;
+	case E6809_REG_DP:
+		return cpu->reg_dp & 0xff;
+	case E6809_REG_CC:
+		return get_reg_cc (cpu) & 0xff;
+	}
+
+	return 0;
+}
+
+void e6809_set_reg (e6809_t *cpu, unsigned reg, unsigned value)
+{
+	switch (reg) {
+	case E6809_REG_X:
+		cpu->reg_x = value;
+		break;
+	case E6809_REG_Y:
+		cpu->reg_y = value;
+		break;
+	case E6809_REG_U:
+		cpu->reg_u = value;
+		break;
+	case E6809_REG_S:
+		cpu->reg_s = value;
+		break;
+	case E6809_REG_PC:
+		cpu->reg_pc = value;
+		break;
+	case E6809_REG_A:
+		cpu->reg_a = value & 0xff;
+		break;
+	case E6809_REG_B:
+		cpu->reg_b = value & 0xff;
+		break;
+	case E6809_REG_D:
+		set_reg_d (cpu, value);
+		break;
+	case E6809_REG_DP:
+		cpu->reg_dp = value & 0xff;
+		break;
+	case E6809_REG_CC:
+		set_reg_cc (cpu, value & 0xff);
+		break;
+	}
+}
+
+unsigned e6809_read8 (e6809_t *cpu, unsigned short address)
+{
+	return read8 (cpu, address);
+}
+
+void e6809_write8 (e6809_t *cpu, unsigned short address, unsigned char data)
+{
+	write8 (cpu, address, data);
+}
+
+void e6809_spend (e6809_t *cpu, int cycles)
+{
+	cpu->run_cycles += cycles;
+}
+
+int e6809_budget (e6809_t *cpu)
+{
+	return cpu->run_limit - cpu->run_cycles;
+}
+
+#ifdef E6809_PROFILE
+
+/* the op code as text, e.g. 10 8e ldy */
+
+static const char *profile_op (unsigned long op, char *buf)
+{
+	const char *name;
+
+	name = e6809_ops[op >> 8][op & 0xff].name;
+
+	if (name == NULL) {
+		name = "?";
+	}
+
+	if (op >> 8) {
+		sprintf (buf, "%02lx %02lx %s", 0x0f + (op >> 8), op & 0xff, name);
+	} else {
+		sprintf (buf, "%02lx %s", op, name);
+	}
+
+	return buf;
+}
+
+static const unsigned long *sort_base;
+
+static int profile_cmp (const void *a, const void *b)
+{
+	unsigned long ca, cb;
+
+	ca = sort_base[*(const unsigned *) a * 2];
+	cb = sort_base[*(const unsigned *) b * 2];
+
+	return (ca < cb) - (ca > cb);
+}
+
+static void profile_ngrams (FILE *f, ngram_t *table, unsigned n)
+{
+	static unsigned order[PROF_NGRAMS];
+	unsigned i, j, used;
+	char buf[3][16];
+
+	used = 0;
+
+	for (i = 0; i < PROF_NGRAMS; i++) {
+		if (table[i].key) {
+			order[used++] = i;
+		}
+	}
+
+	sort_base = &table[0].count;
+	qsort (order, used, sizeof (order[0]), profile_cmp);
+
+	for (i = 0; i < used; i++) {
+		unsigned long key = table[order[i]].key - 1;
+
+		fprintf (f, "%10lu ", table[order[i]].count);
+
+		for (j = n; j-- > 0; ) {
+			fprintf (f, "  %-11s", profile_op ((key >> (j * 10)) & 0x3ff, buf[j]));
+		}
+
+		fprintf (f, "\n");
+	}
+}
+
+/* write the profile collected so far to path and start over. op codes
+ * and sequences are sorted by how often they ran.
+ */
+
+void e6809_profile_dump (e6809_t *cpu, const char *path)
+{
+	struct e6809_profile *p;
+	static unsigned long ops[PROF_OPS][2];
+	static unsigned order[PROF_OPS];
+	unsigned long total, cycles;
+	unsigned i, used;
+	char buf[16];
+	FILE *f;
+
+	p = cpu->profile;
+
+	if (p == NULL) {
+		return;
+	}
+
+	f = fopen (path, "w");
+
+	if (f != NULL) {
+		total = cycles = 0;
+		used = 0;
+
+		for (i = 0; i < PROF_OPS; i++) {
+			ops[i][0] = p->count[i];
+			ops[i][1] = p->cycles[i];
+			total += p->count[i];
+			cycles += p->cycles[i];
+
+			if (p->count[i]) {
+				order[used++] = i;
+			}
+		}
+
+		sort_base = &ops[0][0];
+		qsort (order, used, sizeof (order[0]), profile_cmp);
+
+		fprintf (f, "# instructions %lu cycles %lu idle cycles skipped %lu\n",
+			total, cycles, p->idle);
+		fprintf (f, "# op code, count, cycles, %% of instructions\n");
+
+		for (i = 0; i < used; i++) {
+			fprintf (f, "%-11s %10lu %10lu %6.2f\n", profile_op (order[i], buf),
+				ops[order[i]][0], ops[order[i]][1], ops[order[i]][0] * 100.0 / total);
+		}
+
+		fprintf (f, "# sequences of 2 op codes\n");
+		profile_ngrams (f, p->seq2, 2);
+		fprintf (f, "# sequences of 3 op codes (%lu did not fit)\n", p->lost);
+		profile_ngrams (f, p->seq3, 3);
+
+		fclose (f);
+	}
+
+	free (p);
+	cpu->profile = NULL;
 }
 
+#endif
@@ -1,12 +1,290 @@
 #ifndef __E6809_H
 #define __E6809_H
 
-/* user defined read and write functions */
+typedef struct e6809 e6809_t;
 
-extern unsigned char (*e6809_read8) (unsigned short address);
-extern void (*e6809_write8) (unsigned short  address, unsigned char data);
+/* user defined read and write functions for memory mapped i/o */
 
-void e6809_reset (void);
-unsigned short e6809_sstep (unsigned short irq_i, unsigned short irq_f);
+typedef unsigned char (*e6809_read_t) (e6809_t *cpu, unsigned short address);
+typedef void (*e6809_write_t) (e6809_t *cpu, unsigned short address, unsigned char data);
 
-#endif
\ No newline at end of file
+/* high level emulation of a routine, see e6809_trap */
+
+typedef int (*e6809_trap_t) (e6809_t *cpu);
+
+enum {
+	E6809_DCACHE_SIZE	= 8192, /* decoded instruction slots, a power of two */
+	E6809_DCACHE_MAXLEN	= 5,    /* longest 6809 instruction */
+	E6809_TRAPS			= 32    /* trapped addresses */
+};
+
+/* a decoded instruction */
+
+typedef struct {
+	unsigned int (*handler) (e6809_t *cpu);
+	unsigned short pc;
+	unsigned char len;    /* 0 if the slot is empty */
+	unsigned char oplen;  /* op code bytes, 2 with a page 1/2 prefix */
+	unsigned char mode;   /* addressing mode */
+	unsigned char cycles; /* base cycles, the handler returns the extra ones */
+	unsigned char bytes[E6809_DCACHE_MAXLEN];
+#ifdef E6809_THREADED
+	unsigned short thread; /* label of the handler in run_threaded */
+#endif
+} e6809_dcache_t;
+
+/* translated basic blocks, see block_exec in e6809.c */
+
+enum {
+	E6809_BLOCKS		= 512, /* block slots, a power of two */
+	E6809_BLOCK_UOPS	= 32   /* micro-ops per block */
+};
+
+typedef struct {
+	unsigned char op;
+	unsigned char reg;
+	unsigned char flags;   /* condition codes to compute, the others are dead */
+	unsigned char aux;     /* index mode or branch op code */
+	unsigned char io;      /* how an indexed access uses memory */
+	unsigned short arg;
+	unsigned short pc;     /* the instruction the micro-op belongs to */
+	unsigned short cycles; /* of the block up to that instruction */
+} e6809_uop_t;
+
+typedef struct {
+	unsigned short pc;
+	unsigned char used;    /* 0 if the slot is empty */
+	unsigned char nuops;   /* 0 if the code at pc is left to the interpreter */
+	unsigned char dp_used; /* direct addresses were resolved with dp */
+	unsigned char dp;
+	unsigned short cycles; /* of the whole block */
+	unsigned short last;   /* of its last instruction */
+	e6809_uop_t uops[E6809_BLOCK_UOPS];
+} e6809_block_t;
+
+/* complete state of one cpu. there are no globals in the core, so any
+ * number of these can run side by side, also on different threads. the
+ * members are private to e6809.c, the rest of the program only needs the
+ * size and the user pointer. the registers and whatever every instruction
+ * touches come first, the big tables last.
+ */
+
+struct e6809 {
+	unsigned short reg_x, reg_y;   /* index registers */
+	unsigned short reg_u;          /* user stack pointer */
+	unsigned short reg_s;          /* hardware stack pointer */
+	unsigned short reg_pc;         /* program counter */
+	unsigned short reg_a, reg_b;   /* accumulators */
+	unsigned short reg_dp;         /* direct page register */
+	unsigned short reg_cc;         /* condition codes */
+
+	/* lazy condition codes, see cc_defer */
+
+	unsigned short cc_lazy, cc_kind;
+	unsigned short cc_i0, cc_i1, cc_r;
+
+	unsigned short irq_status;     /* sync/cwai */
+
+	/* state of e6809_run */
+
+	unsigned short run_sync;
+	unsigned short run_wrote;      /* a write happened, see e6809_run */
+	unsigned short run_volatile;   /* an i/o read that may change by itself */
+	int run_cycles;
+	int run_limit;                 /* budget of the run, 0 outside e6809_run */
+
+	const unsigned char *fetch;    /* operand bytes of the current instruction */
+	unsigned dcache_watched;       /* cached instructions in watched memory */
+	unsigned fuse;                 /* decode superinstructions, see e6809_fuse */
+	unsigned translate;            /* run translated blocks, see e6809_translate */
+	unsigned recompiled;           /* the roms match E6809_RECOMPILED */
+
+	void *user;                    /* free for the owner, e.g. for the i/o handlers */
+
+#ifdef E6809_PROFILE
+	struct e6809_profile *profile; /* allocated on first use */
+#endif
+
+	/* memory map, one entry per 256 byte page */
+
+	unsigned char *map_rd[256];
+	unsigned char *map_wr[256];
+	e6809_read_t io_rd[256];
+	e6809_write_t io_wr[256];
+	unsigned char dcache_page[256];
+	unsigned char dcache_alias[256];
+	unsigned char open_bus[256];
+
+	/* traps, trap_page counts the ones in each page */
+
+	unsigned traps;
+	unsigned short trap_pc[E6809_TRAPS];
+	e6809_trap_t trap_fn[E6809_TRAPS];
+	unsigned char trap_page[256];
+	unsigned char discard[256];
+
+	e6809_dcache_t scratch;
+	e6809_dcache_t dcache[E6809_DCACHE_SIZE];
+	e6809_block_t blocks[E6809_BLOCKS];
+};
+
+/* addressing modes */
+
+enum {
+	E6809_AM_ILL,   /* undefined op code */
+	E6809_AM_INH,   /* inherent */
+	E6809_AM_IMM8,  /* 8-bit immediate or post byte (pshs, tfr ...) */
+	E6809_AM_IMM16,
+	E6809_AM_DIR,
+	E6809_AM_EXT,
+	E6809_AM_IDX,
+	E6809_AM_REL8,
+	E6809_AM_REL16,
+	E6809_AM_PAGE   /* page 1 or page 2 prefix */
+};
+
+/* what there is to know about an op code, see e6809tab.c */
+
+typedef struct {
+	const char *name;     /* mnemonic, NULL if undefined */
+	unsigned char mode;   /* E6809_AM_* */
+	unsigned char len;    /* bytes with prefix and operand, but without the
+	                       * bytes that follow an indexed post byte */
+	unsigned char cycles; /* base cycles */
+} e6809_opinfo_t;
+
+/* indexed addressing post bytes */
+
+enum {
+	E6809_REG_X,
+	E6809_REG_Y,
+	E6809_REG_U,
+	E6809_REG_S,
+	E6809_REG_PC,
+	E6809_REG_NONE,
+	E6809_REG_A,     /* the others only for e6809_get_reg/e6809_set_reg */
+	E6809_REG_B,
+	E6809_REG_D,
+	E6809_REG_DP,
+	E6809_REG_CC
+};
+
+enum {
+	E6809_IDX_ILL,   /* undefined post byte */
+	E6809_IDX_OFF5,  /* 5-bit offset,R */
+	E6809_IDX_ZERO,  /* ,R */
+	E6809_IDX_INC,   /* ,R+ / ,R++ */
+	E6809_IDX_DEC,   /* ,-R / ,--R */
+	E6809_IDX_A,     /* A,R */
+	E6809_IDX_B,     /* B,R */
+	E6809_IDX_D,     /* D,R */
+	E6809_IDX_OFF8,  /* 8-bit offset,R */
+	E6809_IDX_OFF16, /* 16-bit offset,R */
+	E6809_IDX_EXT    /* [address] */
+};
+
+typedef struct {
+	unsigned char reg;    /* E6809_REG_* */
+	unsigned char kind;   /* E6809_IDX_* */
+	signed char offset;   /* the 5-bit offset or the increment/decrement */
+	unsigned char cycles; /* on top of the base cycles of the instruction */
+	unsigned char len;    /* bytes following the post byte */
+	unsigned char indirect;
+} e6809_postbyte_t;
+
+extern const e6809_opinfo_t e6809_ops[3][256];
+extern const e6809_postbyte_t e6809_postbytes[256];
+
+/* disassemble the instruction in bytes (at least 5 of them), located at
+ * pc, into text. returns the length of the instruction.
+ */
+
+unsigned e6809_disasm (const unsigned char *bytes, unsigned short pc, char *text);
+
+/* attributes of a memory region for the decoded instruction cache */
+
+enum {
+	E6809_MAP_NONE	= 0, /* code fetched from here is decoded every time */
+	E6809_MAP_ROM	= 1, /* immutable, code is decoded once */
+	E6809_MAP_ALIAS	= 2, /* mirror of a ram region, writes invalidate the copy */
+	E6809_MAP_RAM	= 3  /* code is cached until the memory is written */
+};
+
+/* map the pages from start to end to host memory (mem) or to i/o handlers
+ * (io). if both are NULL, reads return 0xff and writes are ignored.
+ */
+
+void e6809_map_read (e6809_t *cpu, unsigned start, unsigned end, unsigned char *mem, e6809_read_t io);
+void e6809_map_write (e6809_t *cpu, unsigned start, unsigned end, unsigned char *mem, e6809_write_t io);
+void e6809_dcache_map (e6809_t *cpu, unsigned start, unsigned end, unsigned attr, unsigned alias);
+void e6809_reset (e6809_t *cpu);
+unsigned short e6809_sstep (e6809_t *cpu, unsigned short irq_i, unsigned short irq_f);
+
+/* batched execution. e6809_run returns the number of cycles it executed.
+ * while it runs, i/o handlers can ask how many cycles have passed before
+ * the current instruction (e6809_elapsed) and make it return after the
+ * current instruction (e6809_sync).
+ */
+
+int e6809_run (e6809_t *cpu, int cycles, unsigned short irq_i, unsigned short irq_f);
+void e6809_sync (e6809_t *cpu);
+int e6809_elapsed (e6809_t *cpu);
+
+/* e6809_run skips over loops that poll memory without changing anything,
+ * up to the end of its budget. this relies on i/o registers keeping their
+ * value until something ends the run (the caller limits the budget to the
+ * next peripheral event, handlers call e6809_sync). read handlers call
+ * e6809_volatile when the value they return can change all by itself,
+ * e.g. a running timer, so loops reading it are not skipped.
+ */
+
+void e6809_volatile (e6809_t *cpu);
+
+/* with fusion on, pairs of instructions that often follow each other in
+ * rom are decoded into one superinstruction. the results are the same as
+ * without, the switch is there to check exactly that. off after the cpu
+ * state was zeroed.
+ */
+
+void e6809_fuse (e6809_t *cpu, unsigned on);
+
+/* with translation on, e6809_run executes straight-line code in rom as
+ * translated blocks. the results are the same as without. off after the
+ * cpu state was zeroed. neither this nor e6809_fuse has an effect in a
+ * profiling build, its profile is of the plain instruction stream.
+ */
+
+void e6809_translate (e6809_t *cpu, unsigned on);
+
+/* high level emulation. a trap is called instead of the instruction at
+ * its address, with the pc still pointing there. it either returns 0
+ * without having changed anything, and the instruction runs as usual, or
+ * it does the work of the whole routine starting there and returns 1.
+ * it then has to leave the registers as the routine would and pass the
+ * time with e6809_spend, so that i/o handlers see the right e6809_elapsed
+ * while it accesses memory with e6809_read8 and e6809_write8. outside of
+ * e6809_run, or if e6809_budget is too small for the routine, it should
+ * decline. e6809_trap with a NULL trap removes the one at address. traps
+ * are not called from recompiled code that runs into them without a jump.
+ */
+
+void e6809_trap (e6809_t *cpu, unsigned short address, e6809_trap_t trap);
+unsigned e6809_get_reg (e6809_t *cpu, unsigned reg);
+void e6809_set_reg (e6809_t *cpu, unsigned reg, unsigned value);
+unsigned e6809_read8 (e6809_t *cpu, unsigned short address);
+void e6809_write8 (e6809_t *cpu, unsigned short address, unsigned char data);
+void e6809_spend (e6809_t *cpu, int cycles);
+int e6809_budget (e6809_t *cpu);
+
+#ifdef E6809_PROFILE
+
+/* built with E6809_PROFILE the cpu counts the op codes and sequences of
+ * op codes it executes. e6809_profile_dump writes them to a text file and
+ * starts a new profile.
+ */
+
+void e6809_profile_dump (e6809_t *cpu, const char *path);
+
+#endif
+
+#endif
@@ -0,0 +1,735 @@
+#include <stdio.h>
+#include <string.h>
+#include "e6809.h"
+
+/* op code and indexed mode post byte tables of the 6809. the decoder in
+ * e6809.c, the disassembler below and the profiler all work from these.
+ * the cycles are the ones the emulator has always used.
+ */
+
+const e6809_opinfo_t e6809_ops[3][256] = {
+	{
+		[0x00] = {"neg",   E6809_AM_DIR, 2, 6},
+		[0x01] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x02] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x03] = {"com",   E6809_AM_DIR, 2, 6},
+		[0x04] = {"lsr",   E6809_AM_DIR, 2, 6},
+		[0x05] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x06] = {"ror",   E6809_AM_DIR, 2, 6},
+		[0x07] = {"asr",   E6809_AM_DIR, 2, 6},
+		[0x08] = {"asl",   E6809_AM_DIR, 2, 6},
+		[0x09] = {"rol",   E6809_AM_DIR, 2, 6},
+		[0x0a] = {"dec",   E6809_AM_DIR, 2, 6},
+		[0x0b] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x0c] = {"inc",   E6809_AM_DIR, 2, 6},
+		[0x0d] = {"tst",   E6809_AM_DIR, 2, 6},
+		[0x0e] = {"jmp",   E6809_AM_DIR, 2, 3},
+		[0x0f] = {"clr",   E6809_AM_DIR, 2, 6},
+		[0x10] = {NULL,    E6809_AM_PAGE, 1, 0},
+		[0x11] = {NULL,    E6809_AM_PAGE, 1, 0},
+		[0x12] = {"nop",   E6809_AM_INH, 1, 2},
+		[0x13] = {"sync",  E6809_AM_INH, 1, 2},
+		[0x14] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x15] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x16] = {"lbra",  E6809_AM_REL16, 3, 5},
+		[0x17] = {"lbsr",  E6809_AM_REL16, 3, 9},
+		[0x18] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x19] = {"daa",   E6809_AM_INH, 1, 2},
+		[0x1a] = {"orcc",  E6809_AM_IMM8, 2, 3},
+		[0x1b] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x1c] = {"andcc", E6809_AM_IMM8, 2, 3},
+		[0x1d] = {"sex",   E6809_AM_INH, 1, 2},
+		[0x1e] = {"exg",   E6809_AM_IMM8, 2, 8},
+		[0x1f] = {"tfr",   E6809_AM_IMM8, 2, 6},
+		[0x20] = {"bra",   E6809_AM_REL8, 2, 3},
+		[0x21] = {"brn",   E6809_AM_REL8, 2, 3},
+		[0x22] = {"bhi",   E6809_AM_REL8, 2, 3},
+		[0x23] = {"bls",   E6809_AM_REL8, 2, 3},
+		[0x24] = {"bcc",   E6809_AM_REL8, 2, 3},
+		[0x25] = {"bcs",   E6809_AM_REL8, 2, 3},
+		[0x26] = {"bne",   E6809_AM_REL8, 2, 3},
+		[0x27] = {"beq",   E6809_AM_REL8, 2, 3},
+		[0x28] = {"bvc",   E6809_AM_REL8, 2, 3},
+		[0x29] = {"bvs",   E6809_AM_REL8, 2, 3},
+		[0x2a] = {"bpl",   E6809_AM_REL8, 2, 3},
+		[0x2b] = {"bmi",   E6809_AM_REL8, 2, 3},
+		[0x2c] = {"bge",   E6809_AM_REL8, 2, 3},
+		[0x2d] = {"blt",   E6809_AM_REL8, 2, 3},
+		[0x2e] = {"bgt",   E6809_AM_REL8, 2, 3},
+		[0x2f] = {"ble",   E6809_AM_REL8, 2, 3},
+		[0x30] = {"leax",  E6809_AM_IDX, 2, 4},
+		[0x31] = {"leay",  E6809_AM_IDX, 2, 4},
+		[0x32] = {"leas",  E6809_AM_IDX, 2, 4},
+		[0x33] = {"leau",  E6809_AM_IDX, 2, 4},
+		[0x34] = {"pshs",  E6809_AM_IMM8, 2, 5},
+		[0x35] = {"puls",  E6809_AM_IMM8, 2, 5},
+		[0x36] = {"pshu",  E6809_AM_IMM8, 2, 5},
+		[0x37] = {"pulu",  E6809_AM_IMM8, 2, 5},
+		[0x38] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x39] = {"rts",   E6809_AM_INH, 1, 5},
+		[0x3a] = {"abx",   E6809_AM_INH, 1, 3},
+		[0x3b] = {"rti",   E6809_AM_INH, 1, 3},
+		[0x3c] = {"cwai",  E6809_AM_IMM8, 2, 4},
+		[0x3d] = {"mul",   E6809_AM_INH, 1, 11},
+		[0x3e] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x3f] = {"swi",   E6809_AM_INH, 1, 7},
+		[0x40] = {"nega",  E6809_AM_INH, 1, 2},
+		[0x41] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x42] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x43] = {"coma",  E6809_AM_INH, 1, 2},
+		[0x44] = {"lsra",  E6809_AM_INH, 1, 2},
+		[0x45] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x46] = {"rora",  E6809_AM_INH, 1, 2},
+		[0x47] = {"asra",  E6809_AM_INH, 1, 2},
+		[0x48] = {"asla",  E6809_AM_INH, 1, 2},
+		[0x49] = {"rola",  E6809_AM_INH, 1, 2},
+		[0x4a] = {"deca",  E6809_AM_INH, 1, 2},
+		[0x4b] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x4c] = {"inca",  E6809_AM_INH, 1, 2},
+		[0x4d] = {"tsta",  E6809_AM_INH, 1, 2},
+		[0x4e] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x4f] = {"clra",  E6809_AM_INH, 1, 2},
+		[0x50] = {"negb",  E6809_AM_INH, 1, 2},
+		[0x51] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x52] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x53] = {"comb",  E6809_AM_INH, 1, 2},
+		[0x54] = {"lsrb",  E6809_AM_INH, 1, 2},
+		[0x55] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x56] = {"rorb",  E6809_AM_INH, 1, 2},
+		[0x57] = {"asrb",  E6809_AM_INH, 1, 2},
+		[0x58] = {"aslb",  E6809_AM_INH, 1, 2},
+		[0x59] = {"rolb",  E6809_AM_INH, 1, 2},
+		[0x5a] = {"decb",  E6809_AM_INH, 1, 2},
+		[0x5b] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x5c] = {"incb",  E6809_AM_INH, 1, 2},
+		[0x5d] = {"tstb",  E6809_AM_INH, 1, 2},
+		[0x5e] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x5f] = {"clrb",  E6809_AM_INH, 1, 2},
+		[0x60] = {"neg",   E6809_AM_IDX, 2, 6},
+		[0x61] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x62] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x63] = {"com",   E6809_AM_IDX, 2, 6},
+		[0x64] = {"lsr",   E6809_AM_IDX, 2, 6},
+		[0x65] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x66] = {"ror",   E6809_AM_IDX, 2, 6},
+		[0x67] = {"asr",   E6809_AM_IDX, 2, 6},
+		[0x68] = {"asl",   E6809_AM_IDX, 2, 6},
+		[0x69] = {"rol",   E6809_AM_IDX, 2, 6},
+		[0x6a] = {"dec",   E6809_AM_IDX, 2, 6},
+		[0x6b] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x6c] = {"inc",   E6809_AM_IDX, 2, 6},
+		[0x6d] = {"tst",   E6809_AM_IDX, 2, 6},
+		[0x6e] = {"jmp",   E6809_AM_IDX, 2, 3},
+		[0x6f] = {"clr",   E6809_AM_IDX, 2, 6},
+		[0x70] = {"neg",   E6809_AM_EXT, 3, 7},
+		[0x71] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x72] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x73] = {"com",   E6809_AM_EXT, 3, 7},
+		[0x74] = {"lsr",   E6809_AM_EXT, 3, 7},
+		[0x75] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x76] = {"ror",   E6809_AM_EXT, 3, 7},
+		[0x77] = {"asr",   E6809_AM_EXT, 3, 7},
+		[0x78] = {"asl",   E6809_AM_EXT, 3, 7},
+		[0x79] = {"rol",   E6809_AM_EXT, 3, 7},
+		[0x7a] = {"dec",   E6809_AM_EXT, 3, 7},
+		[0x7b] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x7c] = {"inc",   E6809_AM_EXT, 3, 7},
+		[0x7d] = {"tst",   E6809_AM_EXT, 3, 7},
+		[0x7e] = {"jmp",   E6809_AM_EXT, 3, 4},
+		[0x7f] = {"clr",   E6809_AM_EXT, 3, 7},
+		[0x80] = {"suba",  E6809_AM_IMM8, 2, 2},
+		[0x81] = {"cmpa",  E6809_AM_IMM8, 2, 2},
+		[0x82] = {"sbca",  E6809_AM_IMM8, 2, 2},
+		[0x83] = {"subd",  E6809_AM_IMM16, 3, 4},
+		[0x84] = {"anda",  E6809_AM_IMM8, 2, 2},
+		[0x85] = {"bita",  E6809_AM_IMM8, 2, 2},
+		[0x86] = {"lda",   E6809_AM_IMM8, 2, 2},
+		[0x87] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x88] = {"eora",  E6809_AM_IMM8, 2, 2},
+		[0x89] = {"adca",  E6809_AM_IMM8, 2, 2},
+		[0x8a] = {"ora",   E6809_AM_IMM8, 2, 2},
+		[0x8b] = {"adda",  E6809_AM_IMM8, 2, 2},
+		[0x8c] = {"cmpx",  E6809_AM_IMM16, 3, 4},
+		[0x8d] = {"bsr",   E6809_AM_REL8, 2, 7},
+		[0x8e] = {"ldx",   E6809_AM_IMM16, 3, 3},
+		[0x8f] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0x90] = {"suba",  E6809_AM_DIR, 2, 4},
+		[0x91] = {"cmpa",  E6809_AM_DIR, 2, 4},
+		[0x92] = {"sbca",  E6809_AM_DIR, 2, 4},
+		[0x93] = {"subd",  E6809_AM_DIR, 2, 6},
+		[0x94] = {"anda",  E6809_AM_DIR, 2, 4},
+		[0x95] = {"bita",  E6809_AM_DIR, 2, 4},
+		[0x96] = {"lda",   E6809_AM_DIR, 2, 4},
+		[0x97] = {"sta",   E6809_AM_DIR, 2, 4},
+		[0x98] = {"eora",  E6809_AM_DIR, 2, 4},
+		[0x99] = {"adca",  E6809_AM_DIR, 2, 4},
+		[0x9a] = {"ora",   E6809_AM_DIR, 2, 4},
+		[0x9b] = {"adda",  E6809_AM_DIR, 2, 4},
+		[0x9c] = {"cmpx",  E6809_AM_DIR, 2, 6},
+		[0x9d] = {"jsr",   E6809_AM_DIR, 2, 7},
+		[0x9e] = {"ldx",   E6809_AM_DIR, 2, 5},
+		[0x9f] = {"stx",   E6809_AM_DIR, 2, 5},
+		[0xa0] = {"suba",  E6809_AM_IDX, 2, 4},
+		[0xa1] = {"cmpa",  E6809_AM_IDX, 2, 4},
+		[0xa2] = {"sbca",  E6809_AM_IDX, 2, 4},
+		[0xa3] = {"subd",  E6809_AM_IDX, 2, 6},
+		[0xa4] = {"anda",  E6809_AM_IDX, 2, 4},
+		[0xa5] = {"bita",  E6809_AM_IDX, 2, 4},
+		[0xa6] = {"lda",   E6809_AM_IDX, 2, 4},
+		[0xa7] = {"sta",   E6809_AM_IDX, 2, 4},
+		[0xa8] = {"eora",  E6809_AM_IDX, 2, 4},
+		[0xa9] = {"adca",  E6809_AM_IDX, 2, 4},
+		[0xaa] = {"ora",   E6809_AM_IDX, 2, 4},
+		[0xab] = {"adda",  E6809_AM_IDX, 2, 4},
+		[0xac] = {"cmpx",  E6809_AM_IDX, 2, 6},
+		[0xad] = {"jsr",   E6809_AM_IDX, 2, 7},
+		[0xae] = {"ldx",   E6809_AM_IDX, 2, 5},
+		[0xaf] = {"stx",   E6809_AM_IDX, 2, 5},
+		[0xb0] = {"suba",  E6809_AM_EXT, 3, 5},
+		[0xb1] = {"cmpa",  E6809_AM_EXT, 3, 5},
+		[0xb2] = {"sbca",  E6809_AM_EXT, 3, 5},
+		[0xb3] = {"subd",  E6809_AM_EXT, 3, 7},
+		[0xb4] = {"anda",  E6809_AM_EXT, 3, 5},
+		[0xb5] = {"bita",  E6809_AM_EXT, 3, 5},
+		[0xb6] = {"lda",   E6809_AM_EXT, 3, 5},
+		[0xb7] = {"sta",   E6809_AM_EXT, 3, 5},
+		[0xb8] = {"eora",  E6809_AM_EXT, 3, 5},
+		[0xb9] = {"adca",  E6809_AM_EXT, 3, 5},
+		[0xba] = {"ora",   E6809_AM_EXT, 3, 5},
+		[0xbb] = {"adda",  E6809_AM_EXT, 3, 5},
+		[0xbc] = {"cmpx",  E6809_AM_EXT, 3, 7},
+		[0xbd] = {"jsr",   E6809_AM_EXT, 3, 8},
+		[0xbe] = {"ldx",   E6809_AM_EXT, 3, 6},
+		[0xbf] = {"stx",   E6809_AM_EXT, 3, 6},
+		[0xc0] = {"subb",  E6809_AM_IMM8, 2, 2},
+		[0xc1] = {"cmpb",  E6809_AM_IMM8, 2, 2},
+		[0xc2] = {"sbcb",  E6809_AM_IMM8, 2, 2},
+		[0xc3] = {"addd",  E6809_AM_IMM16, 3, 4},
+		[0xc4] = {"andb",  E6809_AM_IMM8, 2, 2},
+		[0xc5] = {"bitb",  E6809_AM_IMM8, 2, 2},
+		[0xc6] = {"ldb",   E6809_AM_IMM8, 2, 2},
+		[0xc7] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0xc8] = {"eorb",  E6809_AM_IMM8, 2, 2},
+		[0xc9] = {"adcb",  E6809_AM_IMM8, 2, 2},
+		[0xca] = {"orb",   E6809_AM_IMM8, 2, 2},
+		[0xcb] = {"addb",  E6809_AM_IMM8, 2, 2},
+		[0xcc] = {"ldd",   E6809_AM_IMM16, 3, 3},
+		[0xcd] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0xce] = {"ldu",   E6809_AM_IMM16, 3, 3},
+		[0xcf] = {NULL,    E6809_AM_ILL, 1, 0},
+		[0xd0] = {"subb",  E6809_AM_DIR, 2, 4},
+		[0xd1] = {"cmpb",  E6809_AM_DIR, 2, 4},
+		[0xd2] = {"sbcb",  E6809_AM_DIR, 2, 4},
+		[0xd3] = {"addd",  E6809_AM_DIR, 2, 6},
+		[0xd4] = {"andb",  E6809_AM_DIR, 2, 4},
+		[0xd5] = {"bitb",  E6809_AM_DIR, 2, 4},
+		[0xd6] = {"ldb",   E6809_AM_DIR, 2, 4},
+		[0xd7] = {"stb",   E6809_AM_DIR, 2, 4},
+		[0xd8] = {"eorb",  E6809_AM_DIR, 2, 4},
+		[0xd9] = {"adcb",  E6809_AM_DIR, 2, 4},
+		[0xda] = {"orb",   E6809_AM_DIR, 2, 4},
+		[0xdb] = {"addb",  E6809_AM_DIR, 2, 4},
+		[0xdc] = {"ldd",   E6809_AM_DIR, 2, 5},
+		[0xdd] = {"std",   E6809_AM_DIR, 2, 5},
+		[0xde] = {"ldu",   E6809_AM_DIR, 2, 5},
+		[0xdf] = {"stu",   E6809_AM_DIR, 2, 5},
+		[0xe0] = {"subb",  E6809_AM_IDX, 2, 4},
+		[0xe1] = {"cmpb",  E6809_AM_IDX, 2, 4},
+		[0xe2] = {"sbcb",  E6809_AM_IDX, 2, 4},
+		[0xe3] = {"addd",  E6809_AM_IDX, 2, 6},
+		[0xe4] = {"andb",  E6809_AM_IDX, 2, 4},
+		[0xe5] = {"bitb",  E6809_AM_IDX, 2, 4},
+		[0xe6] = {"ldb",   E6809_AM_IDX, 2, 4},
+		[0xe7] = {"stb",   E6809_AM_IDX, 2, 4},
+		[0xe8] = {"eorb",  E6809_AM_IDX, 2, 4},
+		[0xe9] = {"adcb",  E6809_AM_IDX, 2, 4},
+		[0xea] = {"orb",   E6809_AM_IDX, 2, 4},
+		[0xeb] = {"addb",  E6809_AM_IDX, 2, 4},
+		[0xec] = {"ldd",   E6809_AM_IDX, 2, 5},
+		[0xed] = {"std",   E6809_AM_IDX, 2, 5},
+		[0xee] = {"ldu",   E6809_AM_IDX, 2, 5},
+		[0xef] = {"stu",   E6809_AM_IDX, 2, 5},
+		[0xf0] = {"subb",  E6809_AM_EXT, 3, 5},
+		[0xf1] = {"cmpb",  E6809_AM_EXT, 3, 5},
+		[0xf2] = {"sbcb",  E6809_AM_EXT, 3, 5},
+		[0xf3] = {"addd",  E6809_AM_EXT, 3, 7},
+		[0xf4] = {"andb",  E6809_AM_EXT, 3, 5},
+		[0xf5] = {"bitb",  E6809_AM_EXT, 3, 5},
+		[0xf6] = {"ldb",   E6809_AM_EXT, 3, 5},
+		[0xf7] = {"stb",   E6809_AM_EXT, 3, 5},
+		[0xf8] = {"eorb",  E6809_AM_EXT, 3, 5},
+		[0xf9] = {"adcb",  E6809_AM_EXT, 3, 5},
+		[0xfa] = {"orb",   E6809_AM_EXT, 3, 5},
+		[0xfb] = {"addb",  E6809_AM_EXT, 3, 5},
+		[0xfc] = {"ldd",   E6809_AM_EXT, 3, 6},
+		[0xfd] = {"std",   E6809_AM_EXT, 3, 6},
+		[0xfe] = {"ldu",   E6809_AM_EXT, 3, 6},
+		[0xff] = {"stu",   E6809_AM_EXT, 3, 6},
+	}, {
+		[0x20] = {"lbra",  E6809_AM_REL16, 4, 5},
+		[0x21] = {"lbrn",  E6809_AM_REL16, 4, 5},
+		[0x22] = {"lbhi",  E6809_AM_REL16, 4, 5},
+		[0x23] = {"lbls",  E6809_AM_REL16, 4, 5},
+		[0x24] = {"lbcc",  E6809_AM_REL16, 4, 5},
+		[0x25] = {"lbcs",  E6809_AM_REL16, 4, 5},
+		[0x26] = {"lbne",  E6809_AM_REL16, 4, 5},
+		[0x27] = {"lbeq",  E6809_AM_REL16, 4, 5},
+		[0x28] = {"lbvc",  E6809_AM_REL16, 4, 5},
+		[0x29] = {"lbvs",  E6809_AM_REL16, 4, 5},
+		[0x2a] = {"lbpl",  E6809_AM_REL16, 4, 5},
+		[0x2b] = {"lbmi",  E6809_AM_REL16, 4, 5},
+		[0x2c] = {"lbge",  E6809_AM_REL16, 4, 5},
+		[0x2d] = {"lblt",  E6809_AM_REL16, 4, 5},
+		[0x2e] = {"lbgt",  E6809_AM_REL16, 4, 5},
+		[0x2f] = {"lble",  E6809_AM_REL16, 4, 5},
+		[0x3f] = {"swi2",  E6809_AM_INH, 2, 8},
+		[0x83] = {"cmpd",  E6809_AM_IMM16, 4, 5},
+		[0x8c] = {"cmpy",  E6809_AM_IMM16, 4, 5},
+		[0x8e] = {"ldy",   E6809_AM_IMM16, 4, 4},
+		[0x93] = {"cmpd",  E6809_AM_DIR, 3, 7},
+		[0x9c] = {"cmpy",  E6809_AM_DIR, 3, 7},
+		[0x9e] = {"ldy",   E6809_AM_DIR, 3, 6},
+		[0x9f] = {"sty",   E6809_AM_DIR, 3, 6},
+		[0xa3] = {"cmpd",  E6809_AM_IDX, 3, 7},
+		[0xac] = {"cmpy",  E6809_AM_IDX, 3, 7},
+		[0xae] = {"ldy",   E6809_AM_IDX, 3, 6},
+		[0xaf] = {"sty",   E6809_AM_IDX, 3, 6},
+		[0xb3] = {"cmpd",  E6809_AM_EXT, 4, 8},
+		[0xbc] = {"cmpy",  E6809_AM_EXT, 4, 8},
+		[0xbe] = {"ldy",   E6809_AM_EXT, 4, 7},
+		[0xbf] = {"sty",   E6809_AM_EXT, 4, 7},
+		[0xce] = {"lds",   E6809_AM_IMM16, 4, 4},
+		[0xde] = {"lds",   E6809_AM_DIR, 3, 6},
+		[0xdf] = {"sts",   E6809_AM_DIR, 3, 6},
+		[0xee] = {"lds",   E6809_AM_IDX, 3, 6},
+		[0xef] = {"sts",   E6809_AM_IDX, 3, 6},
+		[0xfe] = {"lds",   E6809_AM_EXT, 4, 7},
+		[0xff] = {"sts",   E6809_AM_EXT, 4, 7},
+	}, {
+		[0x3f] = {"swi3",  E6809_AM_INH, 2, 8},
+		[0x83] = {"cmpu",  E6809_AM_IMM16, 4, 5},
+		[0x8c] = {"cmps",  E6809_AM_IMM16, 4, 5},
+		[0x93] = {"cmpu",  E6809_AM_DIR, 3, 7},
+		[0x9c] = {"cmps",  E6809_AM_DIR, 3, 7},
+		[0xa3] = {"cmpu",  E6809_AM_IDX, 3, 7},
+		[0xac] = {"cmps",  E6809_AM_IDX, 3, 7},
+		[0xb3] = {"cmpu",  E6809_AM_EXT, 4, 8},
+		[0xbc] = {"cmps",  E6809_AM_EXT, 4, 8},
+	}
+};
+
+/* the emulator accepts [,R+] and [,-R] although a real 6809 does not */
+
+const e6809_postbyte_t e6809_postbytes[256] = {
+	{E6809_REG_X,    E6809_IDX_OFF5,    0, 1, 0, 0}, /* 00 0,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    1, 1, 0, 0}, /* 01 1,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    2, 1, 0, 0}, /* 02 2,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    3, 1, 0, 0}, /* 03 3,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    4, 1, 0, 0}, /* 04 4,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    5, 1, 0, 0}, /* 05 5,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    6, 1, 0, 0}, /* 06 6,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    7, 1, 0, 0}, /* 07 7,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    8, 1, 0, 0}, /* 08 8,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,    9, 1, 0, 0}, /* 09 9,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   10, 1, 0, 0}, /* 0a 10,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   11, 1, 0, 0}, /* 0b 11,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   12, 1, 0, 0}, /* 0c 12,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   13, 1, 0, 0}, /* 0d 13,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   14, 1, 0, 0}, /* 0e 14,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   15, 1, 0, 0}, /* 0f 15,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,  -16, 1, 0, 0}, /* 10 -16,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,  -15, 1, 0, 0}, /* 11 -15,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,  -14, 1, 0, 0}, /* 12 -14,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,  -13, 1, 0, 0}, /* 13 -13,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,  -12, 1, 0, 0}, /* 14 -12,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,  -11, 1, 0, 0}, /* 15 -11,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,  -10, 1, 0, 0}, /* 16 -10,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -9, 1, 0, 0}, /* 17 -9,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -8, 1, 0, 0}, /* 18 -8,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -7, 1, 0, 0}, /* 19 -7,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -6, 1, 0, 0}, /* 1a -6,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -5, 1, 0, 0}, /* 1b -5,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -4, 1, 0, 0}, /* 1c -4,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -3, 1, 0, 0}, /* 1d -3,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -2, 1, 0, 0}, /* 1e -2,x */
+	{E6809_REG_X,    E6809_IDX_OFF5,   -1, 1, 0, 0}, /* 1f -1,x */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    0, 1, 0, 0}, /* 20 0,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    1, 1, 0, 0}, /* 21 1,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    2, 1, 0, 0}, /* 22 2,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    3, 1, 0, 0}, /* 23 3,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    4, 1, 0, 0}, /* 24 4,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    5, 1, 0, 0}, /* 25 5,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    6, 1, 0, 0}, /* 26 6,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    7, 1, 0, 0}, /* 27 7,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    8, 1, 0, 0}, /* 28 8,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,    9, 1, 0, 0}, /* 29 9,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   10, 1, 0, 0}, /* 2a 10,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   11, 1, 0, 0}, /* 2b 11,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   12, 1, 0, 0}, /* 2c 12,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   13, 1, 0, 0}, /* 2d 13,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   14, 1, 0, 0}, /* 2e 14,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   15, 1, 0, 0}, /* 2f 15,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,  -16, 1, 0, 0}, /* 30 -16,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,  -15, 1, 0, 0}, /* 31 -15,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,  -14, 1, 0, 0}, /* 32 -14,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,  -13, 1, 0, 0}, /* 33 -13,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,  -12, 1, 0, 0}, /* 34 -12,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,  -11, 1, 0, 0}, /* 35 -11,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,  -10, 1, 0, 0}, /* 36 -10,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -9, 1, 0, 0}, /* 37 -9,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -8, 1, 0, 0}, /* 38 -8,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -7, 1, 0, 0}, /* 39 -7,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -6, 1, 0, 0}, /* 3a -6,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -5, 1, 0, 0}, /* 3b -5,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -4, 1, 0, 0}, /* 3c -4,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -3, 1, 0, 0}, /* 3d -3,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -2, 1, 0, 0}, /* 3e -2,y */
+	{E6809_REG_Y,    E6809_IDX_OFF5,   -1, 1, 0, 0}, /* 3f -1,y */
+	{E6809_REG_U,    E6809_IDX_OFF5,    0, 1, 0, 0}, /* 40 0,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    1, 1, 0, 0}, /* 41 1,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    2, 1, 0, 0}, /* 42 2,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    3, 1, 0, 0}, /* 43 3,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    4, 1, 0, 0}, /* 44 4,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    5, 1, 0, 0}, /* 45 5,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    6, 1, 0, 0}, /* 46 6,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    7, 1, 0, 0}, /* 47 7,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    8, 1, 0, 0}, /* 48 8,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,    9, 1, 0, 0}, /* 49 9,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   10, 1, 0, 0}, /* 4a 10,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   11, 1, 0, 0}, /* 4b 11,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   12, 1, 0, 0}, /* 4c 12,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   13, 1, 0, 0}, /* 4d 13,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   14, 1, 0, 0}, /* 4e 14,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   15, 1, 0, 0}, /* 4f 15,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,  -16, 1, 0, 0}, /* 50 -16,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,  -15, 1, 0, 0}, /* 51 -15,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,  -14, 1, 0, 0}, /* 52 -14,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,  -13, 1, 0, 0}, /* 53 -13,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,  -12, 1, 0, 0}, /* 54 -12,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,  -11, 1, 0, 0}, /* 55 -11,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,  -10, 1, 0, 0}, /* 56 -10,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -9, 1, 0, 0}, /* 57 -9,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -8, 1, 0, 0}, /* 58 -8,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -7, 1, 0, 0}, /* 59 -7,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -6, 1, 0, 0}, /* 5a -6,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -5, 1, 0, 0}, /* 5b -5,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -4, 1, 0, 0}, /* 5c -4,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -3, 1, 0, 0}, /* 5d -3,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -2, 1, 0, 0}, /* 5e -2,u */
+	{E6809_REG_U,    E6809_IDX_OFF5,   -1, 1, 0, 0}, /* 5f -1,u */
+	{E6809_REG_S,    E6809_IDX_OFF5,    0, 1, 0, 0}, /* 60 0,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    1, 1, 0, 0}, /* 61 1,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    2, 1, 0, 0}, /* 62 2,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    3, 1, 0, 0}, /* 63 3,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    4, 1, 0, 0}, /* 64 4,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    5, 1, 0, 0}, /* 65 5,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    6, 1, 0, 0}, /* 66 6,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    7, 1, 0, 0}, /* 67 7,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    8, 1, 0, 0}, /* 68 8,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,    9, 1, 0, 0}, /* 69 9,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   10, 1, 0, 0}, /* 6a 10,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   11, 1, 0, 0}, /* 6b 11,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   12, 1, 0, 0}, /* 6c 12,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   13, 1, 0, 0}, /* 6d 13,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   14, 1, 0, 0}, /* 6e 14,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   15, 1, 0, 0}, /* 6f 15,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,  -16, 1, 0, 0}, /* 70 -16,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,  -15, 1, 0, 0}, /* 71 -15,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,  -14, 1, 0, 0}, /* 72 -14,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,  -13, 1, 0, 0}, /* 73 -13,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,  -12, 1, 0, 0}, /* 74 -12,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,  -11, 1, 0, 0}, /* 75 -11,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,  -10, 1, 0, 0}, /* 76 -10,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -9, 1, 0, 0}, /* 77 -9,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -8, 1, 0, 0}, /* 78 -8,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -7, 1, 0, 0}, /* 79 -7,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -6, 1, 0, 0}, /* 7a -6,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -5, 1, 0, 0}, /* 7b -5,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -4, 1, 0, 0}, /* 7c -4,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -3, 1, 0, 0}, /* 7d -3,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -2, 1, 0, 0}, /* 7e -2,s */
+	{E6809_REG_S,    E6809_IDX_OFF5,   -1, 1, 0, 0}, /* 7f -1,s */
+	{E6809_REG_X,    E6809_IDX_INC,     1, 2, 0, 0}, /* 80 ,x+ */
+	{E6809_REG_X,    E6809_IDX_INC,     2, 3, 0, 0}, /* 81 ,x++ */
+	{E6809_REG_X,    E6809_IDX_DEC,     1, 2, 0, 0}, /* 82 ,-x */
+	{E6809_REG_X,    E6809_IDX_DEC,     2, 3, 0, 0}, /* 83 ,--x */
+	{E6809_REG_X,    E6809_IDX_ZERO,    0, 0, 0, 0}, /* 84 ,x */
+	{E6809_REG_X,    E6809_IDX_B,       0, 1, 0, 0}, /* 85 b,x */
+	{E6809_REG_X,    E6809_IDX_A,       0, 1, 0, 0}, /* 86 a,x */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* 87 illegal */
+	{E6809_REG_X,    E6809_IDX_OFF8,    0, 1, 1, 0}, /* 88 n8,x */
+	{E6809_REG_X,    E6809_IDX_OFF16,   0, 4, 2, 0}, /* 89 n16,x */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* 8a illegal */
+	{E6809_REG_X,    E6809_IDX_D,       0, 4, 0, 0}, /* 8b d,x */
+	{E6809_REG_PC,   E6809_IDX_OFF8,    0, 1, 1, 0}, /* 8c n8,pc */
+	{E6809_REG_PC,   E6809_IDX_OFF16,   0, 5, 2, 0}, /* 8d n16,pc */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* 8e illegal */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* 8f illegal */
+	{E6809_REG_X,    E6809_IDX_INC,     1, 5, 0, 1}, /* 90 [,x+] */
+	{E6809_REG_X,    E6809_IDX_INC,     2, 6, 0, 1}, /* 91 [,x++] */
+	{E6809_REG_X,    E6809_IDX_DEC,     1, 5, 0, 1}, /* 92 [,-x] */
+	{E6809_REG_X,    E6809_IDX_DEC,     2, 6, 0, 1}, /* 93 [,--x] */
+	{E6809_REG_X,    E6809_IDX_ZERO,    0, 3, 0, 1}, /* 94 [,x] */
+	{E6809_REG_X,    E6809_IDX_B,       0, 4, 0, 1}, /* 95 [b,x] */
+	{E6809_REG_X,    E6809_IDX_A,       0, 4, 0, 1}, /* 96 [a,x] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* 97 illegal */
+	{E6809_REG_X,    E6809_IDX_OFF8,    0, 4, 1, 1}, /* 98 [n8,x] */
+	{E6809_REG_X,    E6809_IDX_OFF16,   0, 7, 2, 1}, /* 99 [n16,x] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* 9a illegal */
+	{E6809_REG_X,    E6809_IDX_D,       0, 7, 0, 1}, /* 9b [d,x] */
+	{E6809_REG_PC,   E6809_IDX_OFF8,    0, 4, 1, 1}, /* 9c [n8,pc] */
+	{E6809_REG_PC,   E6809_IDX_OFF16,   0, 8, 2, 1}, /* 9d [n16,pc] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* 9e illegal */
+	{E6809_REG_NONE, E6809_IDX_EXT,     0, 5, 2, 1}, /* 9f [n16] */
+	{E6809_REG_Y,    E6809_IDX_INC,     1, 2, 0, 0}, /* a0 ,y+ */
+	{E6809_REG_Y,    E6809_IDX_INC,     2, 3, 0, 0}, /* a1 ,y++ */
+	{E6809_REG_Y,    E6809_IDX_DEC,     1, 2, 0, 0}, /* a2 ,-y */
+	{E6809_REG_Y,    E6809_IDX_DEC,     2, 3, 0, 0}, /* a3 ,--y */
+	{E6809_REG_Y,    E6809_IDX_ZERO,    0, 0, 0, 0}, /* a4 ,y */
+	{E6809_REG_Y,    E6809_IDX_B,       0, 1, 0, 0}, /* a5 b,y */
+	{E6809_REG_Y,    E6809_IDX_A,       0, 1, 0, 0}, /* a6 a,y */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* a7 illegal */
+	{E6809_REG_Y,    E6809_IDX_OFF8,    0, 1, 1, 0}, /* a8 n8,y */
+	{E6809_REG_Y,    E6809_IDX_OFF16,   0, 4, 2, 0}, /* a9 n16,y */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* aa illegal */
+	{E6809_REG_Y,    E6809_IDX_D,       0, 4, 0, 0}, /* ab d,y */
+	{E6809_REG_PC,   E6809_IDX_OFF8,    0, 1, 1, 0}, /* ac n8,pc */
+	{E6809_REG_PC,   E6809_IDX_OFF16,   0, 5, 2, 0}, /* ad n16,pc */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* ae illegal */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* af illegal */
+	{E6809_REG_Y,    E6809_IDX_INC,     1, 5, 0, 1}, /* b0 [,y+] */
+	{E6809_REG_Y,    E6809_IDX_INC,     2, 6, 0, 1}, /* b1 [,y++] */
+	{E6809_REG_Y,    E6809_IDX_DEC,     1, 5, 0, 1}, /* b2 [,-y] */
+	{E6809_REG_Y,    E6809_IDX_DEC,     2, 6, 0, 1}, /* b3 [,--y] */
+	{E6809_REG_Y,    E6809_IDX_ZERO,    0, 3, 0, 1}, /* b4 [,y] */
+	{E6809_REG_Y,    E6809_IDX_B,       0, 4, 0, 1}, /* b5 [b,y] */
+	{E6809_REG_Y,    E6809_IDX_A,       0, 4, 0, 1}, /* b6 [a,y] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* b7 illegal */
+	{E6809_REG_Y,    E6809_IDX_OFF8,    0, 4, 1, 1}, /* b8 [n8,y] */
+	{E6809_REG_Y,    E6809_IDX_OFF16,   0, 7, 2, 1}, /* b9 [n16,y] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* ba illegal */
+	{E6809_REG_Y,    E6809_IDX_D,       0, 7, 0, 1}, /* bb [d,y] */
+	{E6809_REG_PC,   E6809_IDX_OFF8,    0, 4, 1, 1}, /* bc [n8,pc] */
+	{E6809_REG_PC,   E6809_IDX_OFF16,   0, 8, 2, 1}, /* bd [n16,pc] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* be illegal */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* bf illegal */
+	{E6809_REG_U,    E6809_IDX_INC,     1, 2, 0, 0}, /* c0 ,u+ */
+	{E6809_REG_U,    E6809_IDX_INC,     2, 3, 0, 0}, /* c1 ,u++ */
+	{E6809_REG_U,    E6809_IDX_DEC,     1, 2, 0, 0}, /* c2 ,-u */
+	{E6809_REG_U,    E6809_IDX_DEC,     2, 3, 0, 0}, /* c3 ,--u */
+	{E6809_REG_U,    E6809_IDX_ZERO,    0, 0, 0, 0}, /* c4 ,u */
+	{E6809_REG_U,    E6809_IDX_B,       0, 1, 0, 0}, /* c5 b,u */
+	{E6809_REG_U,    E6809_IDX_A,       0, 1, 0, 0}, /* c6 a,u */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* c7 illegal */
+	{E6809_REG_U,    E6809_IDX_OFF8,    0, 1, 1, 0}, /* c8 n8,u */
+	{E6809_REG_U,    E6809_IDX_OFF16,   0, 4, 2, 0}, /* c9 n16,u */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* ca illegal */
+	{E6809_REG_U,    E6809_IDX_D,       0, 4, 0, 0}, /* cb d,u */
+	{E6809_REG_PC,   E6809_IDX_OFF8,    0, 1, 1, 0}, /* cc n8,pc */
+	{E6809_REG_PC,   E6809_IDX_OFF16,   0, 5, 2, 0}, /* cd n16,pc */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* ce illegal */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* cf illegal */
+	{E6809_REG_U,    E6809_IDX_INC,     1, 5, 0, 1}, /* d0 [,u+] */
+	{E6809_REG_U,    E6809_IDX_INC,     2, 6, 0, 1}, /* d1 [,u++] */
+	{E6809_REG_U,    E6809_IDX_DEC,     1, 5, 0, 1}, /* d2 [,-u] */
+	{E6809_REG_U,    E6809_IDX_DEC,     2, 6, 0, 1}, /* d3 [,--u] */
+	{E6809_REG_U,    E6809_IDX_ZERO,    0, 3, 0, 1}, /* d4 [,u] */
+	{E6809_REG_U,    E6809_IDX_B,       0, 4, 0, 1}, /* d5 [b,u] */
+	{E6809_REG_U,    E6809_IDX_A,       0, 4, 0, 1}, /* d6 [a,u] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* d7 illegal */
+	{E6809_REG_U,    E6809_IDX_OFF8,    0, 4, 1, 1}, /* d8 [n8,u] */
+	{E6809_REG_U,    E6809_IDX_OFF16,   0, 7, 2, 1}, /* d9 [n16,u] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* da illegal */
+	{E6809_REG_U,    E6809_IDX_D,       0, 7, 0, 1}, /* db [d,u] */
+	{E6809_REG_PC,   E6809_IDX_OFF8,    0, 4, 1, 1}, /* dc [n8,pc] */
+	{E6809_REG_PC,   E6809_IDX_OFF16,   0, 8, 2, 1}, /* dd [n16,pc] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* de illegal */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* df illegal */
+	{E6809_REG_S,    E6809_IDX_INC,     1, 2, 0, 0}, /* e0 ,s+ */
+	{E6809_REG_S,    E6809_IDX_INC,     2, 3, 0, 0}, /* e1 ,s++ */
+	{E6809_REG_S,    E6809_IDX_DEC,     1, 2, 0, 0}, /* e2 ,-s */
+	{E6809_REG_S,    E6809_IDX_DEC,     2, 3, 0, 0}, /* e3 ,--s */
+	{E6809_REG_S,    E6809_IDX_ZERO,    0, 0, 0, 0}, /* e4 ,s */
+	{E6809_REG_S,    E6809_IDX_B,       0, 1, 0, 0}, /* e5 b,s */
+	{E6809_REG_S,    E6809_IDX_A,       0, 1, 0, 0}, /* e6 a,s */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* e7 illegal */
+	{E6809_REG_S,    E6809_IDX_OFF8,    0, 1, 1, 0}, /* e8 n8,s */
+	{E6809_REG_S,    E6809_IDX_OFF16,   0, 4, 2, 0}, /* e9 n16,s */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* ea illegal */
+	{E6809_REG_S,    E6809_IDX_D,       0, 4, 0, 0}, /* eb d,s */
+	{E6809_REG_PC,   E6809_IDX_OFF8,    0, 1, 1, 0}, /* ec n8,pc */
+	{E6809_REG_PC,   E6809_IDX_OFF16,   0, 5, 2, 0}, /* ed n16,pc */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* ee illegal */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* ef illegal */
+	{E6809_REG_S,    E6809_IDX_INC,     1, 5, 0, 1}, /* f0 [,s+] */
+	{E6809_REG_S,    E6809_IDX_INC,     2, 6, 0, 1}, /* f1 [,s++] */
+	{E6809_REG_S,    E6809_IDX_DEC,     1, 5, 0, 1}, /* f2 [,-s] */
+	{E6809_REG_S,    E6809_IDX_DEC,     2, 6, 0, 1}, /* f3 [,--s] */
+	{E6809_REG_S,    E6809_IDX_ZERO,    0, 3, 0, 1}, /* f4 [,s] */
+	{E6809_REG_S,    E6809_IDX_B,       0, 4, 0, 1}, /* f5 [b,s] */
+	{E6809_REG_S,    E6809_IDX_A,       0, 4, 0, 1}, /* f6 [a,s] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* f7 illegal */
+	{E6809_REG_S,    E6809_IDX_OFF8,    0, 4, 1, 1}, /* f8 [n8,s] */
+	{E6809_REG_S,    E6809_IDX_OFF16,   0, 7, 2, 1}, /* f9 [n16,s] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* fa illegal */
+	{E6809_REG_S,    E6809_IDX_D,       0, 7, 0, 1}, /* fb [d,s] */
+	{E6809_REG_PC,   E6809_IDX_OFF8,    0, 4, 1, 1}, /* fc [n8,pc] */
+	{E6809_REG_PC,   E6809_IDX_OFF16,   0, 8, 2, 1}, /* fd [n16,pc] */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* fe illegal */
+	{E6809_REG_NONE, E6809_IDX_ILL,     0, 0, 0, 0}, /* ff illegal */
+};
+
+/* disassembler */
+
+static const char *const reg_names[] = {
+	"x", "y", "u", "s", "pc"
+};
+
+static const char *const exg_names[16] = {
+	"d", "x", "y", "u", "s", "pc", "?", "?",
+	"a", "b", "cc", "dp", "?", "?", "?", "?"
+};
+
+static void disasm_indexed (const unsigned char *arg, char *text)
+{
+	const e6809_postbyte_t *pb;
+	const char *r;
+	char buf[24];
+
+	pb = &e6809_postbytes[arg[0]];
+	r = pb->reg <= E6809_REG_PC ? reg_names[pb->reg] : "";
+
+	switch (pb->kind) {
+	case E6809_IDX_OFF5:
+		sprintf (buf, "%d,%s", pb->offset, r);
+		break;
+	case E6809_IDX_ZERO:
+		sprintf (buf, ",%s", r);
+		break;
+	case E6809_IDX_INC:
+		sprintf (buf, ",%s%s", r, pb->offset == 1 ? "+" : "++");
+		break;
+	case E6809_IDX_DEC:
+		sprintf (buf, ",%s%s", pb->offset == 1 ? "-" : "--", r);
+		break;
+	case E6809_IDX_A:
+		sprintf (buf, "a,%s", r);
+		break;
+	case E6809_IDX_B:
+		sprintf (buf, "b,%s", r);
+		break;
+	case E6809_IDX_D:
+		sprintf (buf, "d,%s", r);
+		break;
+	case E6809_IDX_OFF8:
+		sprintf (buf, "%d,%s", (signed char) arg[1], r);
+		break;
+	case E6809_IDX_OFF16:
+		sprintf (buf, "$%04x,%s", (arg[1] << 8) | arg[2], r);
+		break;
+	case E6809_IDX_EXT:
+		sprintf (buf, "$%04x", (arg[1] << 8) | arg[2]);
+		break;
+	default:
+		sprintf (buf, "?");
+		break;
+	}
+
+	if (pb->indirect) {
+		sprintf (text, "[%s]", buf);
+	} else {
+		sprintf (text, "%s", buf);
+	}
+}
+
+/* the register list of pshs/puls/pshu/pulu */
+
+static void disasm_reglist (unsigned op, unsigned list, char *text)
+{
+	static const char *const names[8] = {
+		"cc", "a", "b", "dp", "x", "y", "u", "pc"
+	};
+	unsigned i;
+
+	*text = 0;
+
+	for (i = 0; i < 8; i++) {
+		if (list & (1 << i)) {
+			if (*text) {
+				strcat (text, ",");
+			}
+
+			/* the other stack pointer */
+
+			strcat (text, (i == 6 && op >= 0x36) ? "s" : names[i]);
+		}
+	}
+}
+
+/* disassemble the instruction in bytes, which sits at address pc, into
+ * text and return its length. bytes has to hold at least 5 bytes.
+ */
+
+unsigned e6809_disasm (const unsigned char *bytes, unsigned short pc, char *text)
+{
+	const e6809_opinfo_t *op;
+	const unsigned char *arg;
+	unsigned len;
+	char *p;
+
+	op = &e6809_ops[0][bytes[0]];
+	arg = bytes + 1;
+
+	if (op->mode == E6809_AM_PAGE) {
+		op = &e6809_ops[bytes[0] - 0x0f][bytes[1]];
+		arg = bytes + 2;
+	}
+
+	if (op->name == NULL) {
+		sprintf (text, "fcb   $%02x", bytes[0]);
+		return 1;
+	}
+
+	len = op->len;
+
+	if (op->mode == E6809_AM_INH) {
+		sprintf (text, "%s", op->name);
+		return len;
+	}
+
+	p = text + sprintf (text, "%-6s", op->name);
+
+	switch (op->mode) {
+	case E6809_AM_IMM8:
+		if (bytes[0] == 0x1e || bytes[0] == 0x1f) {
+			sprintf (p, "%s,%s", exg_names[arg[0] >> 4], exg_names[arg[0] & 0xf]);
+		} else if (bytes[0] >= 0x34 && bytes[0] <= 0x37) {
+			disasm_reglist (bytes[0], arg[0], p);
+		} else {
+			sprintf (p, "#$%02x", arg[0]);
+		}
+
+		break;
+	case E6809_AM_IMM16:
+		sprintf (p, "#$%04x", (arg[0] << 8) | arg[1]);
+		break;
+	case E6809_AM_DIR:
+		sprintf (p, "<$%02x", arg[0]);
+		break;
+	case E6809_AM_EXT:
+		sprintf (p, "$%04x", (arg[0] << 8) | arg[1]);
+		break;
+	case E6809_AM_REL8:
+		sprintf (p, "$%04x", (pc + len + (signed char) arg[0]) & 0xffff);
+		break;
+	case E6809_AM_REL16:
+		sprintf (p, "$%04x", (pc + len + ((arg[0] << 8) | arg[1])) & 0xffff);
+		break;
+	case E6809_AM_IDX:
+		disasm_indexed (arg, p);
+		len += e6809_postbytes[arg[0]].len;
+		break;
+	}
+
+	return len;
+}
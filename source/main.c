@@ -43,6 +43,9 @@ int Vex_cfg_Frameskip;
 int Vex_cfg_Sound;
 int Vex_cfg_Color;
 int Vex_cfg_Overlay;
+int Vex_cfg_Fuse;
+int Vex_cfg_Translate;
+int Vex_cfg_Hle;
 
 int exitemulator;
 
@@ -52,6 +55,13 @@ static int scl_factor;
 
 static unsigned int color_set[VECTREX_COLORS];
 
+/* START and SELECT as seen by osint_input. they open the menu or change
+ * the screen layout, which can reset the machine, so osint_emuloop only
+ * acts on them between two calls of vecx_emu.
+ */
+
+static unsigned int osint_keys;
+
 sftd_font *font;
 static char buffer[64];;
 sf2d_texture *overlay, *splash;
@@ -121,12 +131,27 @@ void osint_reset (void)
 }
 
 
+#ifdef E6809_PROFILE
+/* save the op code profile of the rom that ran so far next to its save states */
+static void osint_profile (void)
+{
+	char path[MAX_PATH];
+
+	sprintf(path, "%s/%s.prof", config_save_path, rom_name_with_no_ext[0] ? rom_name_with_no_ext : "bios");
+	vecx_profile_dump(path);
+}
+#endif
+
 void osint_loadrom (char* load_filename)
 {
 	FILE *rom_file;
 	
    int i;
 
+#ifdef E6809_PROFILE
+	osint_profile();
+#endif
+
     // strip rom name from full path and cut off the extension
     for(i = strlen(load_filename) - 1; i >= 0; i--) {
         if(load_filename[i] == '/' || i == 0) { 
@@ -190,6 +215,9 @@ void set_option_defaults(void)
 	Vex_cfg_Color = 0;
 	Vex_cfg_Overlay = 1;
 	Vex_cfg_Show_FPS = 1;
+	Vex_cfg_Fuse = 1;
+	Vex_cfg_Translate = 0;
+	Vex_cfg_Hle = 1;
 }
 
 /* Parse argument list */
@@ -242,6 +270,21 @@ void parse_args(int argc, char **argv)
             Vex_cfg_Overlay = 0;
         }
 
+        if(strcmp(argv[i], "-nofuse") == 0)
+        {
+            Vex_cfg_Fuse = 0;
+        }
+
+        if(strcmp(argv[i], "-translate") == 0)
+        {
+            Vex_cfg_Translate = 1;
+        }
+
+        if(strcmp(argv[i], "-nohle") == 0)
+        {
+            Vex_cfg_Hle = 0;
+        }
+
      }
 }
 
@@ -280,6 +323,21 @@ void save_config(char *file)
 
         fprintf(handle, "%s %i ", "-color", Vex_cfg_Color);
 
+        if(Vex_cfg_Fuse == 0)
+        {
+            fprintf(handle, "%s ", "-nofuse");
+        }
+
+        if(Vex_cfg_Translate)
+        {
+            fprintf(handle, "%s ", "-translate");
+        }
+
+        if(Vex_cfg_Hle == 0)
+        {
+            fprintf(handle, "%s ", "-nohle");
+        }
+
  
  		fclose(handle);
 }
@@ -323,6 +381,9 @@ static int osint_config (void)
 	load_config(tempfile);
 
 	osint_updatescale ();
+	vecx_fuse (Vex_cfg_Fuse);
+	vecx_translate (Vex_cfg_Translate);
+	vecx_hle (Vex_cfg_Hle);
 
 	sprintf(bios_path_and_name, "%s/%s", config_bios_path, "bios.dat");
 	rom_file = fopen (bios_path_and_name, "rb");
@@ -378,10 +439,41 @@ void osint_gencolors (void)
 	}
 }
 
-void osint_render (void)
+/* draw a list of vectors, moved by (ox, oy) on the screen or, with turn
+ * set, turned a quarter to the left and put ox to the right. the lines of
+ * a strip share their joints, so each joint is only scaled once.
+ */
+
+static void osint_drawlist (const vector_list_t *l, int cnt, int ox, int oy, int turn)
 {
+	float x0 = 0, y0 = 0, x1, y1;
 	int v;
 
+	for (v = 0; v < cnt; v++) {
+		if (!l->join[v]) {
+			x0 = (float)l->x0[v]/(float)scl_factor;
+			y0 = (float)l->y0[v]/(float)scl_factor;
+		}
+
+		x1 = (float)l->x1[v]/(float)scl_factor;
+		y1 = (float)l->y1[v]/(float)scl_factor;
+
+		/* the start is cut to a whole pixel and the end is not, see the
+		 * note in osint_render.
+		 */
+
+		if (turn)
+			sf2d_draw_line (ox-(int)y0, (int)x0, ox-y1, x1, 1, color_set[l->color[v]]);
+		else
+			sf2d_draw_line ((int)x0+ox, (int)y0+oy, x1+ox, y1+oy, 1, color_set[l->color[v]]);
+
+		x0 = x1;
+		y0 = y1;
+	}
+}
+
+void osint_render (void)
+{
 	sf2d_start_frame(GFX_TOP, GFX_LEFT);
 
 // warning: sf2dlib seems to do not show lines starting and ending at the same point. Vecx assumes that in this case should be drawn a point.
@@ -392,51 +484,27 @@ void osint_render (void)
 		if((Vex_cfg_Overlay!=0) & (overlay!=NULL))
 			sf2d_draw_texture_scale(overlay, 103, 0, (float)screen_x/overlay->width, (float)screen_y/overlay->height);
 		else sf2d_draw_rectangle(103, 0, screen_x, screen_y, RGBA8(0x0, 0x0, 0x0, 0xFF));
-		for (v = 0; v < vector_draw_cnt; v++) 
-			sf2d_draw_line (vectors_draw[v].x0/scl_factor+103, vectors_draw[v].y0/scl_factor,
-				(float)vectors_draw[v].x1/(float)scl_factor+103, (float)vectors_draw[v].y1/(float)scl_factor, 1,
-				color_set[vectors_draw[v].color]);
-		for (v = 0; v < vector_erse_cnt; v++) 
-			sf2d_draw_line (vectors_erse[v].x0/scl_factor+103, vectors_erse[v].y0/scl_factor,
-				(float)vectors_erse[v].x1/(float)scl_factor+103, (float)vectors_erse[v].y1/(float)scl_factor, 1,
-				color_set[vectors_erse[v].color]);
+		osint_drawlist (vectors_draw, vector_draw_cnt, 103, 0, 0);
+		osint_drawlist (vectors_erse, vector_erse_cnt, 103, 0, 0);
 	} else 	if (Vex_cfg_Scalemode==1) {
 		if((Vex_cfg_Overlay!=0) & (overlay!=NULL))
 			sf2d_draw_texture_part_rotate_scale(overlay, 200, 120, 1.57, 0, 0, overlay->width, overlay->height, (float)screen_x/overlay->width, (float)screen_y/overlay->height);
 		else sf2d_draw_rectangle(52, 0, screen_y, screen_x, RGBA8(0x0, 0x0, 0x0, 0xFF));	
-		for (v = 0; v < vector_draw_cnt; v++) 
-			sf2d_draw_line (400-51-vectors_draw[v].y0/scl_factor, vectors_draw[v].x0/scl_factor, 
-				400-51-(float)vectors_draw[v].y1/(float)scl_factor, (float)vectors_draw[v].x1/(float)scl_factor, 1,
-				color_set[vectors_draw[v].color]);
-		for (v = 0; v < vector_erse_cnt; v++) 
-			sf2d_draw_line (400-51-vectors_erse[v].y0/scl_factor, vectors_erse[v].x0/scl_factor, 
-				400-51-(float)vectors_erse[v].y1/(float)scl_factor, (float)vectors_erse[v].x1/(float)scl_factor, 1,
-				color_set[vectors_erse[v].color]);
+		osint_drawlist (vectors_draw, vector_draw_cnt, 400-51, 0, 1);
+		osint_drawlist (vectors_erse, vector_erse_cnt, 400-51, 0, 1);
 	} else 	if (Vex_cfg_Scalemode==2) {
 		if((Vex_cfg_Overlay!=0) & (overlay!=NULL))
 			sf2d_draw_texture_scale(overlay, 40, 41, (float)screen_x/overlay->width, (float)screen_y/overlay->height);
 		else sf2d_draw_rectangle(40, 41, screen_x, screen_y, RGBA8(0x0, 0x0, 0x0, 0xFF));
-		for (v = 0; v < vector_draw_cnt; v++) 
-			sf2d_draw_line (vectors_draw[v].x0/scl_factor+40, vectors_draw[v].y0/scl_factor+41,
-				(float)vectors_draw[v].x1/(float)scl_factor+40, (float)vectors_draw[v].y1/(float)scl_factor+41, 1,
-				color_set[vectors_draw[v].color]);
-		for (v = 0; v < vector_erse_cnt; v++) 
-			sf2d_draw_line (vectors_erse[v].x0/scl_factor+40, vectors_erse[v].y0/scl_factor+41,
-				(float)vectors_erse[v].x1/(float)scl_factor+40, (float)vectors_erse[v].y1/(float)scl_factor+41, 1,
-				color_set[vectors_erse[v].color]);
+		osint_drawlist (vectors_draw, vector_draw_cnt, 40, 41, 0);
+		osint_drawlist (vectors_erse, vector_erse_cnt, 40, 41, 0);
 	} else {
 		if((Vex_cfg_Overlay!=0) & (overlay!=NULL))
 			sf2d_draw_texture_scale(overlay, 40, 0, (float)screen_x/overlay->width, (float)screen_y/overlay->height);
 		else sf2d_draw_rectangle(40, 0, screen_x, screen_y, RGBA8(0x0, 0x0, 0x0, 0xFF));
 		sf2d_draw_rectangle(0, 199, 400, 320, RGBA8(0x0f, 0x0, 0x0, 0x80));
-		for (v = 0; v < vector_draw_cnt; v++) 
-			sf2d_draw_line (vectors_draw[v].x0/scl_factor+40, vectors_draw[v].y0/scl_factor,
-				(float)vectors_draw[v].x1/(float)scl_factor+40, (float)vectors_draw[v].y1/(float)scl_factor, 1,
-				color_set[vectors_draw[v].color]);
-		for (v = 0; v < vector_erse_cnt; v++) 
-			sf2d_draw_line (vectors_erse[v].x0/scl_factor+40, vectors_erse[v].y0/scl_factor,
-				(float)vectors_erse[v].x1/(float)scl_factor+40, (float)vectors_erse[v].y1/(float)scl_factor, 1,
-				color_set[vectors_erse[v].color]);
+		osint_drawlist (vectors_draw, vector_draw_cnt, 40, 0, 0);
+		osint_drawlist (vectors_erse, vector_erse_cnt, 40, 0, 0);
 	}
 
 
@@ -449,27 +517,15 @@ void osint_render (void)
 		if((Vex_cfg_Overlay!=0) & (overlay!=NULL))
 			sf2d_draw_texture_scale(overlay, 0, -198, (float)screen_x/overlay->width, (float)screen_y/overlay->height);
 		else sf2d_draw_rectangle(0, -198, screen_x, screen_y, RGBA8(0x0, 0x0, 0x0, 0xFF));
-		for (v = 0; v < vector_draw_cnt; v++) 
-			sf2d_draw_line (vectors_draw[v].x0/scl_factor, vectors_draw[v].y0/scl_factor-198,
-				(float)vectors_draw[v].x1/(float)scl_factor, (float)vectors_draw[v].y1/(float)scl_factor-198, 1,
-				color_set[vectors_draw[v].color]);
-		for (v = 0; v < vector_erse_cnt; v++) 
-			sf2d_draw_line (vectors_erse[v].x0/scl_factor, vectors_erse[v].y0/scl_factor-198,
-				(float)vectors_erse[v].x1/(float)scl_factor, (float)vectors_erse[v].y1/(float)scl_factor-198, 1,
-				color_set[vectors_erse[v].color]);
+		osint_drawlist (vectors_draw, vector_draw_cnt, 0, -198, 0);
+		osint_drawlist (vectors_erse, vector_erse_cnt, 0, -198, 0);
 	} 	else if (Vex_cfg_Scalemode==3) {
 		if((Vex_cfg_Overlay!=0) & (overlay!=NULL))
 			sf2d_draw_texture_scale(overlay, 0, -158, (float)screen_x/overlay->width, (float)screen_y/overlay->height);
 		else sf2d_draw_rectangle(0, 0, screen_x, screen_y, RGBA8(0x0, 0x0, 0x0, 0xFF));
 		sf2d_draw_rectangle(0, 0, 320, 41, RGBA8(0x0f, 0x0, 0x0, 0x80));
-		for (v = 0; v < vector_draw_cnt; v++) 
-			sf2d_draw_line (vectors_draw[v].x0/scl_factor, vectors_draw[v].y0/scl_factor-158,
-				(float)vectors_draw[v].x1/(float)scl_factor, (float)vectors_draw[v].y1/(float)scl_factor-158, 1,
-				color_set[vectors_draw[v].color]);
-		for (v = 0; v < vector_erse_cnt; v++) 
-			sf2d_draw_line (vectors_erse[v].x0/scl_factor, vectors_erse[v].y0/scl_factor-158,
-				(float)vectors_erse[v].x1/(float)scl_factor, (float)vectors_erse[v].y1/(float)scl_factor-158, 1,
-				color_set[vectors_erse[v].color]);
+		osint_drawlist (vectors_draw, vector_draw_cnt, 0, -158, 0);
+		osint_drawlist (vectors_erse, vector_erse_cnt, 0, -158, 0);
 	}
 
 	if (Vex_cfg_Show_FPS) {
@@ -483,20 +539,13 @@ void osint_render (void)
 
 }
 
-void doevents(void)
+/* sample the inputs of the host, called from the input event of vecx_emu */
+
+void osint_input (void)
 {
 
 	hidScanInput();
-	if(keysDown()&KEY_START) 
-	{
-		sound_pause();
-		gui_Run();
-	}
-	if(keysDown()&KEY_SELECT)
-	{
-		if(++Vex_cfg_Scalemode>3) Vex_cfg_Scalemode=0;
-		osint_updatescale ();
-	}
+	osint_keys |= keysDown() & (KEY_START | KEY_SELECT);
 
 	if(keysDown()&KEY_Y) snd_regs[14] &= ~0x01;
 	if(keysDown()&KEY_X) snd_regs[14] &= ~0x02;
@@ -542,11 +591,20 @@ void osint_emuloop (void)
 
 	while (aptMainLoop() && (exitemulator==0)) {
 
-		doevents();
-
-
 		vecx_emu ((VECTREX_MHZ / 1000) * EMU_TIMER);
 
+		if(osint_keys&KEY_START)
+		{
+			sound_pause();
+			gui_Run();
+		}
+		if(osint_keys&KEY_SELECT)
+		{
+			if(++Vex_cfg_Scalemode>3) Vex_cfg_Scalemode=0;
+			osint_updatescale ();
+		}
+		osint_keys = 0;
+
 	}
 
 //exit_emuloop:
@@ -621,6 +679,10 @@ int main(void) {
 /* emulator code */
 	osint_emuloop ();
 
+#ifdef E6809_PROFILE
+	osint_profile();
+#endif
+
 	sound_quit();
 
 	if(overlay) sf2d_free_texture(overlay);
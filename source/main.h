@@ -15,6 +15,7 @@ void osint_reset (void);
 void osint_clearrom(void);
 void osint_loadrom (char* load_filename);
 void osint_timer (void);
+void osint_input (void);
 void save_config(char *file);
 
 #endif
\ No newline at end of file
@@ -14,57 +14,95 @@ unsigned char rom[8192];
 unsigned char cart[32768];
 static unsigned char ram[1024];
 
+/* the 6809 */
+
+static e6809_t vecx_cpu;
+
 /* the sound chip registers */
 
 unsigned snd_regs[16];
 static unsigned snd_select;
 
-/* the via 6522 registers */
-
-static unsigned via_ora;
-static unsigned via_orb;
-static unsigned via_ddra;
-static unsigned via_ddrb;
-static unsigned via_t1on;  /* is timer 1 on? */
-static unsigned via_t1int; /* are timer 1 interrupts allowed? */
-static unsigned via_t1c;
-static unsigned via_t1ll;
-static unsigned via_t1lh;
-static unsigned via_t1pb7; /* timer 1 controlled version of pb7 */
-static unsigned via_t2on;  /* is timer 2 on? */
-static unsigned via_t2int; /* are timer 2 interrupts allowed? */
-static unsigned via_t2c;
-static unsigned via_t2ll;
-static unsigned via_sr;
-static unsigned via_srb;   /* number of bits shifted so far */
-static unsigned via_src;   /* shift counter */
-static unsigned via_srclk;
-static unsigned via_acr;
-static unsigned via_pcr;
-static unsigned via_ifr;
-static unsigned via_ier;
-static unsigned via_ca2;
-static unsigned via_cb2h;  /* basic handshake version of cb2 */
-static unsigned via_cb2s;  /* version of cb2 controlled by the shift register */
+/* the state of the via 6522 and the analog hardware, in one place. the
+ * fields the catch-up and per cycle code work on come first, so they
+ * share the first cache lines, and the flags and 8 bit registers among
+ * them are bytes. the ones only touched on register accesses follow.
+ */
+
+typedef struct {
+	/* hot */
+
+	int via_done;       /* cycles of the current e6809_run the via and
+	                     * analog hardware have been brought up to */
+	unsigned via_t1c;
+	unsigned via_t2c;
+	unsigned via_src;   /* shift counter */
+	unsigned via_sr;
+	int alg_curr_x;     /* current x position */
+	int alg_curr_y;     /* current y position */
+	int alg_dx;         /* delta x */
+	int alg_dy;         /* delta y */
+	int alg_vector_dx;
+	int alg_vector_dy;
+
+	unsigned char via_t1on;  /* is timer 1 on? */
+	unsigned char via_t1int; /* are timer 1 interrupts allowed? */
+	unsigned char via_t1pb7; /* timer 1 controlled version of pb7 */
+	unsigned char via_t2on;  /* is timer 2 on? */
+	unsigned char via_t2int; /* are timer 2 interrupts allowed? */
+	unsigned char via_t2ll;
+	unsigned char via_srb;   /* number of bits shifted so far */
+	unsigned char via_srclk;
+	unsigned char via_orb;
+	unsigned char via_ifr;
+	unsigned char via_ca2;
+	unsigned char via_cb2h;  /* basic handshake version of cb2 */
+	unsigned char via_cb2s;  /* version of cb2 controlled by the shift register */
+	unsigned char alg_zsh;   /* z sample and hold */
+	unsigned char alg_vectoring; /* are we drawing a vector right now? */
+
+	/* the modes set in acr and pcr, decoded by via_decode when they are
+	 * written so the per cycle code does not have to take them apart.
+	 */
+
+	unsigned char via_pb7t1;    /* timer 1 has control of pb7 */
+	unsigned char via_t1free;   /* timer 1 is in continuous interrupt mode */
+	unsigned char via_t2count;  /* timer 2 counts cycles, not pb6 pulses */
+	unsigned char via_srmode;   /* what the shift register does */
+	unsigned char via_blanksr;  /* the shift register drives blank */
+	unsigned char via_ca2pulse; /* ca2 is in pulse mode */
+	unsigned char via_cb2pulse; /* cb2 is in pulse mode */
+	unsigned char via_ca2hs;    /* ca2 is in handshake mode */
+	unsigned char via_cb2hs;    /* cb2 is in handshake mode */
+
+	vector_t alg_vector;
+
+	/* cold */
+
+	unsigned via_ora;
+	unsigned via_ddra;
+	unsigned via_ddrb;
+	unsigned via_t1ll;
+	unsigned via_t1lh;
+	unsigned via_acr;
+	unsigned via_pcr;
+	unsigned via_ier;
+
+	unsigned alg_rsh;  /* zero ref sample and hold */
+	unsigned alg_xsh;  /* x sample and hold */
+	unsigned alg_ysh;  /* y sample and hold */
+	unsigned alg_jsh;  /* joystick sample and hold */
+	unsigned alg_compare;
+} vecx_state_t;
+
+static vecx_state_t vx __attribute__ ((aligned (32)));
 
 /* analog devices */
 
-static unsigned alg_rsh;  /* zero ref sample and hold */
-static unsigned alg_xsh;  /* x sample and hold */
-static unsigned alg_ysh;  /* y sample and hold */
-static unsigned alg_zsh;  /* z sample and hold */
 unsigned alg_jch0;		  /* joystick direction channel 0 */
 unsigned alg_jch1;		  /* joystick direction channel 1 */
 unsigned alg_jch2;		  /* joystick direction channel 2 */
 unsigned alg_jch3;		  /* joystick direction channel 3 */
-static unsigned alg_jsh;  /* joystick sample and hold */
-
-static unsigned alg_compare;
-
-static int alg_dx;     /* delta x */
-static int alg_dy;     /* delta y */
-static int alg_curr_x; /* current x position */
-static int alg_curr_y; /* current y position */
 
 enum {
     // NOP90 - Changed for performances
@@ -74,36 +112,66 @@ enum {
 
 	FCYCLES_INIT    = VECTREX_MHZ / VECTREX_PDECAY,
 
-	/* max number of possible vectors that maybe on the screen at one time.
-	 * one only needs VECTREX_MHZ / VECTREX_PDECAY but we need to also store
-	 * deleted vectors in a single table
+	/* number of 6809 cycles per chunk of sound samples and between two
+	 * looks at the inputs of the host.
 	 */
 
-	VECTOR_CNT		= VECTREX_MHZ / VECTREX_PDECAY,
+	AUDIO_CYCLES	= FCYCLES_INIT,
+	INPUT_CYCLES	= VECTREX_MHZ / 50,
 
-//	VECTOR_HASH     = 65521
-};
+	/* number of slots of the table that finds lines already in the draw
+	 * list, a power of two above VECTOR_CNT.
+	 */
 
-static unsigned alg_vectoring; /* are we drawing a vector right now? */
-static int alg_vector_dx;
-static int alg_vector_dy;
-static vector_t alg_vector;
+	VECTOR_HASH     = 8192
+};
 
 int vector_draw_cnt;
 int vector_erse_cnt;
-static vector_t vectors_set[2 * VECTOR_CNT];
-vector_t *vectors_draw;
-vector_t *vectors_erse;
+static vector_list_t vectors_set[2];
+vector_list_t *vectors_draw;
+vector_list_t *vectors_erse;
+
+/* for every slot, the index in the draw list of the last line that went
+ * there. entries are not cleared between frames, a hit is only believed
+ * if the line at that index is the same.
+ */
+
+static unsigned short vector_hash[VECTOR_HASH];
+
+enum {
+	EVENT_T1,    /* timer 1 may run out */
+	EVENT_T2,    /* timer 2 may run out */
+	EVENT_SR,    /* the shift register may be done */
+	EVENT_AUDIO, /* the next chunk of samples is due */
+	EVENT_FRAME, /* the frame is done */
+	EVENT_INPUT, /* time to sample the inputs of the host */
+	EVENT_CNT
+};
+
+static unsigned vecx_now;            /* cycles since reset */
+static unsigned emu_end;             /* where the current vecx_emu ends */
+static unsigned event_on;            /* the events that are scheduled */
+static unsigned event_at[EVENT_CNT]; /* when, on the vecx_now time line */
 
-//static long vector_hash[VECTOR_HASH];
+/* put an event cycles from now on the time line, or take it off */
+
+static einline void event_set (unsigned event, int cycles)
+{
+	event_at[event] = vecx_now + cycles;
+	event_on |= 1 << event;
+}
 
-static int fcycles;
+static einline void event_clear (unsigned event)
+{
+	event_on &= ~(1 << event);
+}
 
-/* update the snd chips internal registers when via_ora/via_orb changes */
+/* update the snd chips internal registers when vx.via_ora/vx.via_orb changes */
 
 static einline void snd_update (void)
 {
-	switch (via_orb & 0x18) {
+	switch (vx.via_orb & 0x18) {
 	case 0x00:
 		/* the sound chip is disabled */
 		break;
@@ -114,16 +182,16 @@ static einline void snd_update (void)
 		/* the sound chip is recieving data */
 
 		if (snd_select != 14) {
-			snd_regs[snd_select] = via_ora;
-			e8910_write(snd_select, via_ora);
+			snd_regs[snd_select] = vx.via_ora;
+			e8910_write(snd_select, vx.via_ora);
 		}
 
 		break;
 	case 0x18:
 		/* the sound chip is latching an address */
 
-		if ((via_ora & 0xf0) == 0x00) {
-			snd_select = via_ora & 0x0f;
+		if ((vx.via_ora & 0xf0) == 0x00) {
+			snd_select = vx.via_ora & 0x0f;
 		}
 
 		break;
@@ -134,57 +202,73 @@ static einline void snd_update (void)
 
 static einline void alg_update (void)
 {
-	switch (via_orb & 0x06) {
+	switch (vx.via_orb & 0x06) {
 	case 0x00:
-		alg_jsh = alg_jch0;
+		vx.alg_jsh = alg_jch0;
 
-		if ((via_orb & 0x01) == 0x00) {
+		if ((vx.via_orb & 0x01) == 0x00) {
 			/* demultiplexor is on */
-			alg_ysh = alg_xsh;
+			vx.alg_ysh = vx.alg_xsh;
 		}
 
 		break;
 	case 0x02:
-		alg_jsh = alg_jch1;
+		vx.alg_jsh = alg_jch1;
 
-		if ((via_orb & 0x01) == 0x00) {
+		if ((vx.via_orb & 0x01) == 0x00) {
 			/* demultiplexor is on */
-			alg_rsh = alg_xsh;
+			vx.alg_rsh = vx.alg_xsh;
 		}
 
 		break;
 	case 0x04:
-		alg_jsh = alg_jch2;
+		vx.alg_jsh = alg_jch2;
 
-		if ((via_orb & 0x01) == 0x00) {
+		if ((vx.via_orb & 0x01) == 0x00) {
 			/* demultiplexor is on */
 
-			if (alg_xsh > 0x80) {
-				alg_zsh = alg_xsh - 0x80;
+			if (vx.alg_xsh > 0x80) {
+				vx.alg_zsh = vx.alg_xsh - 0x80;
 			} else {
-				alg_zsh = 0;
+				vx.alg_zsh = 0;
 			}
 		}
 
 		break;
 	case 0x06:
 		/* sound output line */
-		alg_jsh = alg_jch3;
+		vx.alg_jsh = alg_jch3;
 		break;
 	}
 
 	/* compare the current joystick direction with a reference */
 
-	if (alg_jsh > alg_xsh) {
-		alg_compare = 0x20;
+	if (vx.alg_jsh > vx.alg_xsh) {
+		vx.alg_compare = 0x20;
 	} else {
-		alg_compare = 0;
+		vx.alg_compare = 0;
 	}
 
 	/* compute the new "deltas" */
 
-	alg_dx = (int) alg_xsh - (int) alg_rsh;
-	alg_dy = (int) alg_rsh - (int) alg_ysh;
+	vx.alg_dx = (int) vx.alg_xsh - (int) vx.alg_rsh;
+	vx.alg_dy = (int) vx.alg_rsh - (int) vx.alg_ysh;
+}
+
+/* decode the modes of acr and pcr after one of them is written */
+
+static void via_decode (void)
+{
+	vx.via_pb7t1 = vx.via_acr & 0x80;
+	vx.via_t1free = vx.via_acr & 0x40;
+	vx.via_t2count = (vx.via_acr & 0x20) == 0x00;
+	vx.via_srmode = vx.via_acr & 0x1c;
+	vx.via_blanksr = vx.via_acr & 0x10;
+
+	vx.via_ca2hs = (vx.via_pcr & 0x0e) == 0x08;
+	vx.via_ca2pulse = (vx.via_pcr & 0x0e) == 0x0a;
+	vx.via_cb2hs = (vx.via_pcr & 0xe0) == 0x80;
+	vx.via_cb2pulse = (vx.via_pcr & 0xe0) == 0xa0;
 }
 
 /* update IRQ and bit-7 of the ifr register after making an adjustment to
@@ -193,333 +277,339 @@ static einline void alg_update (void)
 
 static einline void int_update (void)
 {
-	if ((via_ifr & 0x7f) & (via_ier & 0x7f)) {
-		via_ifr |= 0x80;
+	if ((vx.via_ifr & 0x7f) & (vx.via_ier & 0x7f)) {
+		vx.via_ifr |= 0x80;
 	} else {
-		via_ifr &= 0x7f;
+		vx.via_ifr &= 0x7f;
 	}
 }
 
-unsigned char read8 (unsigned address)
+static void via_catchup (int cycles);
+static void hle_install (void);
+
+/* the via is mapped to the d000 - d7ff page and mirrored every 16 bytes.
+ * the cpu runs ahead of the via, so every access first brings the via up
+ * to the cycle the cpu is at. accesses that may change the interrupt
+ * flags end the current e6809_run. reads of registers that change by
+ * themselves are flagged as volatile so the cpu does not skip a loop
+ * polling them.
+ */
+
+static unsigned char io_read8 (e6809_t *cpu, unsigned short address)
 {
 	unsigned char data;
 
-	if ((address & 0xe000) == 0xe000) {
-		/* rom */
+	via_catchup (e6809_elapsed (cpu));
+
+	switch (address & 0xf) {
+	case 0x0:
+		/* compare signal is an input so the value does not come from
+		 * vx.via_orb.
+		 */
 
-		data = rom[address & 0x1fff];
-	} else if ((address & 0xe000) == 0xc000) {
-		if (address & 0x800) {
-			/* ram */
+		if (vx.via_pb7t1) {
+			/* timer 1 has control of bit 7 */
 
-			data = ram[address & 0x3ff];
-		} else if (address & 0x1000) {
-			/* io */
+			data = (unsigned char) ((vx.via_orb & 0x5f) | vx.via_t1pb7 | vx.alg_compare);
+		} else {
+			/* bit 7 is being driven by vx.via_orb */
 
-			switch (address & 0xf) {
-			case 0x0:
-				/* compare signal is an input so the value does not come from
-				 * via_orb.
-				 */
+			data = (unsigned char) ((vx.via_orb & 0xdf) | vx.alg_compare);
+		}
 
-				if (via_acr & 0x80) {
-					/* timer 1 has control of bit 7 */
+		/* the compare signal follows the integrators */
 
-					data = (unsigned char) ((via_orb & 0x5f) | via_t1pb7 | alg_compare);
-				} else {
-					/* bit 7 is being driven by via_orb */
+		e6809_volatile (cpu);
 
-					data = (unsigned char) ((via_orb & 0xdf) | alg_compare);
-				}
+		break;
+	case 0x1:
+		/* register 1 also performs handshakes if necessary */
 
-				break;
-			case 0x1:
-				/* register 1 also performs handshakes if necessary */
+		if (vx.via_ca2hs) {
+			/* if ca2 is in pulse mode or handshake mode, then it
+			 * goes low whenever ira is read.
+			 */
 
-				if ((via_pcr & 0x0e) == 0x08) {
-					/* if ca2 is in pulse mode or handshake mode, then it
-					 * goes low whenever ira is read.
-					 */
+			vx.via_ca2 = 0;
+		}
 
-					via_ca2 = 0;
-				}
+		/* fall through */
 
-				/* fall through */
+	case 0xf:
+		if ((vx.via_orb & 0x18) == 0x08) {
+			/* the snd chip is driving port a */
 
-			case 0xf:
-				if ((via_orb & 0x18) == 0x08) {
-					/* the snd chip is driving port a */
+			data = (unsigned char) snd_regs[snd_select];
+		} else {
+			data = (unsigned char) vx.via_ora;
+		}
 
-					data = (unsigned char) snd_regs[snd_select];
-				} else {
-					data = (unsigned char) via_ora;
-				}
+		break;
+	case 0x2:
+		data = (unsigned char) vx.via_ddrb;
+		break;
+	case 0x3:
+		data = (unsigned char) vx.via_ddra;
+		break;
+	case 0x4:
+		/* T1 low order counter */
 
-				break;
-			case 0x2:
-				data = (unsigned char) via_ddrb;
-				break;
-			case 0x3:
-				data = (unsigned char) via_ddra;
-				break;
-			case 0x4:
-				/* T1 low order counter */
+		data = (unsigned char) vx.via_t1c;
+		vx.via_ifr &= 0xbf; /* remove timer 1 interrupt flag */
 
-				data = (unsigned char) via_t1c;
-				via_ifr &= 0xbf; /* remove timer 1 interrupt flag */
+		vx.via_t1on = 0; /* timer 1 is stopped */
+		vx.via_t1int = 0;
+		vx.via_t1pb7 = 0x80;
 
-				via_t1on = 0; /* timer 1 is stopped */
-				via_t1int = 0;
-				via_t1pb7 = 0x80;
+		int_update ();
+		e6809_sync (cpu);
 
-				int_update ();
+		break;
+	case 0x5:
+		/* T1 high order counter */
 
-				break;
-			case 0x5:
-				/* T1 high order counter */
+		data = (unsigned char) (vx.via_t1c >> 8);
+		e6809_volatile (cpu);
 
-				data = (unsigned char) (via_t1c >> 8);
+		break;
+	case 0x6:
+		/* T1 low order latch */
 
-				break;
-			case 0x6:
-				/* T1 low order latch */
+		data = (unsigned char) vx.via_t1ll;
+		break;
+	case 0x7:
+		/* T1 high order latch */
 
-				data = (unsigned char) via_t1ll;
-				break;
-			case 0x7:
-				/* T1 high order latch */
+		data = (unsigned char) vx.via_t1lh;
+		break;
+	case 0x8:
+		/* T2 low order counter */
 
-				data = (unsigned char) via_t1lh;
-				break;
-			case 0x8:
-				/* T2 low order counter */
+		data = (unsigned char) vx.via_t2c;
+		vx.via_ifr &= 0xdf; /* remove timer 2 interrupt flag */
 
-				data = (unsigned char) via_t2c;
-				via_ifr &= 0xdf; /* remove timer 2 interrupt flag */
+		vx.via_t2on = 0; /* timer 2 is stopped */
+		vx.via_t2int = 0;
 
-				via_t2on = 0; /* timer 2 is stopped */
-				via_t2int = 0;
+		int_update ();
+		e6809_sync (cpu);
 
-				int_update ();
+		break;
+	case 0x9:
+		/* T2 high order counter */
 
-				break;
-			case 0x9:
-				/* T2 high order counter */
+		data = (unsigned char) (vx.via_t2c >> 8);
+		e6809_volatile (cpu);
+		break;
+	case 0xa:
+		data = (unsigned char) vx.via_sr;
+		vx.via_ifr &= 0xfb; /* remove shift register interrupt flag */
+		vx.via_srb = 0;
+		vx.via_srclk = 1;
 
-				data = (unsigned char) (via_t2c >> 8);
-				break;
-			case 0xa:
-				data = (unsigned char) via_sr;
-				via_ifr &= 0xfb; /* remove shift register interrupt flag */
-				via_srb = 0;
-				via_srclk = 1;
+		int_update ();
+		e6809_sync (cpu);
 
-				int_update ();
+		break;
+	case 0xb:
+		data = (unsigned char) vx.via_acr;
+		break;
+	case 0xc:
+		data = (unsigned char) vx.via_pcr;
+		break;
+	case 0xd:
+		/* interrupt flag register */
 
-				break;
-			case 0xb:
-				data = (unsigned char) via_acr;
-				break;
-			case 0xc:
-				data = (unsigned char) via_pcr;
-				break;
-			case 0xd:
-				/* interrupt flag register */
-
-				data = (unsigned char) via_ifr;
-				break;
-			case 0xe:
-				/* interrupt enable register */
-
-				data = (unsigned char) (via_ier | 0x80);
-				break;
-			}
-		}
-	} else if (address < 0x8000) {
-		/* cartridge */
+		data = (unsigned char) vx.via_ifr;
+		break;
+	case 0xe:
+		/* interrupt enable register */
 
-		data = cart[address];
-	} else {
-		data = 0xff;
+		data = (unsigned char) (vx.via_ier | 0x80);
+		break;
 	}
 
 	return data;
 }
 
-void write8 (unsigned address, unsigned char data)
+static void io_write8 (e6809_t *cpu, unsigned short address, unsigned char data)
 {
-	if ((address & 0xe000) == 0xe000) {
-		/* rom */
-	} else if ((address & 0xe000) == 0xc000) {
-		/* it is possible for both ram and io to be written at the same! */
+	via_catchup (e6809_elapsed (cpu));
 
-		if (address & 0x800) {
-			ram[address & 0x3ff] = data;
-		}
+	switch (address & 0xf) {
+	case 0x0:
+		vx.via_orb = data;
+
+		snd_update ();
 
-		if (address & 0x1000) {
-			switch (address & 0xf) {
-			case 0x0:
-				via_orb = data;
+		alg_update ();
 
-				snd_update ();
+		if (vx.via_cb2hs) {
+			/* if cb2 is in pulse mode or handshake mode, then it
+			 * goes low whenever orb is written.
+			 */
 
-				alg_update ();
+			vx.via_cb2h = 0;
+		}
 
-				if ((via_pcr & 0xe0) == 0x80) {
-					/* if cb2 is in pulse mode or handshake mode, then it
-					 * goes low whenever orb is written.
-					 */
+		break;
+	case 0x1:
+		/* register 1 also performs handshakes if necessary */
 
-					via_cb2h = 0;
-				}
+		if (vx.via_ca2hs) {
+			/* if ca2 is in pulse mode or handshake mode, then it
+			 * goes low whenever ora is written.
+			 */
 
-				break;
-			case 0x1:
-				/* register 1 also performs handshakes if necessary */
+			vx.via_ca2 = 0;
+		}
 
-				if ((via_pcr & 0x0e) == 0x08) {
-					/* if ca2 is in pulse mode or handshake mode, then it
-					 * goes low whenever ora is written.
-					 */
+		/* fall through */
 
-					via_ca2 = 0;
-				}
+	case 0xf:
+		vx.via_ora = data;
 
-				/* fall through */
+		snd_update ();
 
-			case 0xf:
-				via_ora = data;
+		/* output of port a feeds directly into the dac which then
+		 * feeds the x axis sample and hold.
+		 */
 
-				snd_update ();
+		vx.alg_xsh = data ^ 0x80;
 
-				/* output of port a feeds directly into the dac which then
-				 * feeds the x axis sample and hold.
-				 */
+		alg_update ();
 
-				alg_xsh = data ^ 0x80;
+		break;
+	case 0x2:
+		vx.via_ddrb = data;
+		break;
+	case 0x3:
+		vx.via_ddra = data;
+		break;
+	case 0x4:
+		/* T1 low order counter */
 
-				alg_update ();
+		vx.via_t1ll = data;
 
-				break;
-			case 0x2:
-				via_ddrb = data;
-				break;
-			case 0x3:
-				via_ddra = data;
-				break;
-			case 0x4:
-				/* T1 low order counter */
+		break;
+	case 0x5:
+		/* T1 high order counter */
 
-				via_t1ll = data;
+		vx.via_t1lh = data;
+		vx.via_t1c = (vx.via_t1lh << 8) | vx.via_t1ll;
+		vx.via_ifr &= 0xbf; /* remove timer 1 interrupt flag */
 
-				break;
-			case 0x5:
-				/* T1 high order counter */
+		vx.via_t1on = 1; /* timer 1 starts running */
+		vx.via_t1int = 1;
+		vx.via_t1pb7 = 0;
 
-				via_t1lh = data;
-				via_t1c = (via_t1lh << 8) | via_t1ll;
-				via_ifr &= 0xbf; /* remove timer 1 interrupt flag */
+		int_update ();
+		e6809_sync (cpu);
 
-				via_t1on = 1; /* timer 1 starts running */
-				via_t1int = 1;
-				via_t1pb7 = 0;
+		break;
+	case 0x6:
+		/* T1 low order latch */
 
-				int_update ();
+		vx.via_t1ll = data;
+		break;
+	case 0x7:
+		/* T1 high order latch */
 
-				break;
-			case 0x6:
-				/* T1 low order latch */
+		vx.via_t1lh = data;
+		break;
+	case 0x8:
+		/* T2 low order latch */
 
-				via_t1ll = data;
-				break;
-			case 0x7:
-				/* T1 high order latch */
+		vx.via_t2ll = data;
+		break;
+	case 0x9:
+		/* T2 high order latch/counter */
 
-				via_t1lh = data;
-				break;
-			case 0x8:
-				/* T2 low order latch */
+		vx.via_t2c = (data << 8) | vx.via_t2ll;
+		vx.via_ifr &= 0xdf;
 
-				via_t2ll = data;
-				break;
-			case 0x9:
-				/* T2 high order latch/counter */
+		vx.via_t2on = 1; /* timer 2 starts running */
+		vx.via_t2int = 1;
 
-				via_t2c = (data << 8) | via_t2ll;
-				via_ifr &= 0xdf;
+		int_update ();
+		e6809_sync (cpu);
 
-				via_t2on = 1; /* timer 2 starts running */
-				via_t2int = 1;
+		break;
+	case 0xa:
+		vx.via_sr = data;
+		vx.via_ifr &= 0xfb; /* remove shift register interrupt flag */
+		vx.via_srb = 0;
+		vx.via_srclk = 1;
 
-				int_update ();
+		int_update ();
+		e6809_sync (cpu);
 
-				break;
-			case 0xa:
-				via_sr = data;
-				via_ifr &= 0xfb; /* remove shift register interrupt flag */
-				via_srb = 0;
-				via_srclk = 1;
+		break;
+	case 0xb:
+		vx.via_acr = data;
+		via_decode ();
+		e6809_sync (cpu);
+		break;
+	case 0xc:
+		vx.via_pcr = data;
+		via_decode ();
 
-				int_update ();
+		if ((vx.via_pcr & 0x0e) == 0x0c) {
+			/* ca2 is outputting low */
 
-				break;
-			case 0xb:
-				via_acr = data;
-				break;
-			case 0xc:
-				via_pcr = data;
+			vx.via_ca2 = 0;
+		} else {
+			/* ca2 is disabled or in pulse mode or is
+			 * outputting high.
+			 */
 
+			vx.via_ca2 = 1;
+		}
 
-				if ((via_pcr & 0x0e) == 0x0c) {
-					/* ca2 is outputting low */
+		if ((vx.via_pcr & 0xe0) == 0xc0) {
+			/* cb2 is outputting low */
 
-					via_ca2 = 0;
-				} else {
-					/* ca2 is disabled or in pulse mode or is
-					 * outputting high.
-					 */
+			vx.via_cb2h = 0;
+		} else {
+			/* cb2 is disabled or is in pulse mode or is
+			 * outputting high.
+			 */
 
-					via_ca2 = 1;
-				}
+			vx.via_cb2h = 1;
+		}
 
-				if ((via_pcr & 0xe0) == 0xc0) {
-					/* cb2 is outputting low */
+		break;
+	case 0xd:
+		/* interrupt flag register */
 
-					via_cb2h = 0;
-				} else {
-					/* cb2 is disabled or is in pulse mode or is
-					 * outputting high.
-					 */
+		vx.via_ifr &= ~(data & 0x7f);
+		int_update ();
+		e6809_sync (cpu);
 
-					via_cb2h = 1;
-				}
+		break;
+	case 0xe:
+		/* interrupt enable register */
 
-				break;
-			case 0xd:
-				/* interrupt flag register */
+		if (data & 0x80) {
+			vx.via_ier |= data & 0x7f;
+		} else {
+			vx.via_ier &= ~(data & 0x7f);
+		}
 
-				via_ifr &= ~(data & 0x7f);
-				int_update ();
+		int_update ();
+		e6809_sync (cpu);
 
-				break;
-			case 0xe:
-				/* interrupt enable register */
+		break;
+	}
+}
 
-				if (data & 0x80) {
-					via_ier |= data & 0x7f;
-				} else {
-					via_ier &= ~(data & 0x7f);
-				}
+/* in the d800 - dfff page both ram and io are written at the same time! */
 
-				int_update ();
+static void ramio_write8 (e6809_t *cpu, unsigned short address, unsigned char data)
+{
+	ram[address & 0x3ff] = data;
 
-				break;
-			}
-		}
-	} else if (address < 0x8000) {
-		/* cartridge */
-	}
+	io_write8 (cpu, address, data);
 }
 
 void vecx_reset (void)
@@ -544,62 +634,105 @@ void vecx_reset (void)
 
 	snd_select = 0;
 
-	via_ora = 0;
-	via_orb = 0;
-	via_ddra = 0;
-	via_ddrb = 0;
-	via_t1on = 0;
-	via_t1int = 0;
-	via_t1c = 0;
-	via_t1ll = 0;
-	via_t1lh = 0;
-	via_t1pb7 = 0x80;
-	via_t2on = 0;
-	via_t2int = 0;
-	via_t2c = 0;
-	via_t2ll = 0;
-	via_sr = 0;
-	via_srb = 8;
-	via_src = 0;
-	via_srclk = 0;
-	via_acr = 0;
-	via_pcr = 0;
-	via_ifr = 0;
-	via_ier = 0;
-	via_ca2 = 1;
-	via_cb2h = 1;
-	via_cb2s = 0;
-
-	alg_rsh = 128;
-	alg_xsh = 128;
-	alg_ysh = 128;
-	alg_zsh = 0;
+	vx.via_ora = 0;
+	vx.via_orb = 0;
+	vx.via_ddra = 0;
+	vx.via_ddrb = 0;
+	vx.via_t1on = 0;
+	vx.via_t1int = 0;
+	vx.via_t1c = 0;
+	vx.via_t1ll = 0;
+	vx.via_t1lh = 0;
+	vx.via_t1pb7 = 0x80;
+	vx.via_t2on = 0;
+	vx.via_t2int = 0;
+	vx.via_t2c = 0;
+	vx.via_t2ll = 0;
+	vx.via_sr = 0;
+	vx.via_srb = 8;
+	vx.via_src = 0;
+	vx.via_srclk = 0;
+	vx.via_acr = 0;
+	vx.via_pcr = 0;
+	via_decode ();
+	vx.via_ifr = 0;
+	vx.via_ier = 0;
+	vx.via_ca2 = 1;
+	vx.via_cb2h = 1;
+	vx.via_cb2s = 0;
+
+	vx.alg_rsh = 128;
+	vx.alg_xsh = 128;
+	vx.alg_ysh = 128;
+	vx.alg_zsh = 0;
 	alg_jch0 = 128;
 	alg_jch1 = 128;
 	alg_jch2 = 128;
 	alg_jch3 = 128;
-	alg_jsh = 128;
+	vx.alg_jsh = 128;
 
-	alg_compare = 0; /* check this */
+	vx.alg_compare = 0; /* check this */
 
-	alg_dx = 0;
-	alg_dy = 0;
-	alg_curr_x = ALG_MAX_X / 2;
-	alg_curr_y = ALG_MAX_Y / 2;
+	vx.alg_dx = 0;
+	vx.alg_dy = 0;
+	vx.alg_curr_x = ALG_MAX_X / 2;
+	vx.alg_curr_y = ALG_MAX_Y / 2;
 
-	alg_vectoring = 0;
+	vx.alg_vectoring = 0;
 
 	vector_draw_cnt = 0;
 	vector_erse_cnt = 0;
 	vectors_draw = vectors_set;
-	vectors_erse = vectors_set + VECTOR_CNT;
+	vectors_erse = vectors_set + 1;
+
+	/* the first frame is done one cycle after FCYCLES_INIT, the inputs
+	 * are sampled before anything else happens.
+	 */
+
+	vecx_now = 0;
+	emu_end = 0;
+	event_on = 0;
+
+	event_set (EVENT_AUDIO, FCYCLES_INIT + 1);
+	event_set (EVENT_FRAME, FCYCLES_INIT + 1);
+	event_set (EVENT_INPUT, 0);
 
-	fcycles = FCYCLES_INIT;
+	/* memory map. c000 - c7ff is not decoded. the ram lives at c800 -
+	 * cfff and is mirrored over the io page at d800 - dfff.
+	 */
+
+	e6809_map_read (&vecx_cpu, 0x0000, 0x7fff, cart, NULL);
+	e6809_map_read (&vecx_cpu, 0x8000, 0xc7ff, NULL, NULL);
+	e6809_map_read (&vecx_cpu, 0xc800, 0xcbff, ram, NULL);
+	e6809_map_read (&vecx_cpu, 0xcc00, 0xcfff, ram, NULL);
+	e6809_map_read (&vecx_cpu, 0xd000, 0xd7ff, NULL, io_read8);
+	e6809_map_read (&vecx_cpu, 0xd800, 0xdbff, ram, NULL);
+	e6809_map_read (&vecx_cpu, 0xdc00, 0xdfff, ram, NULL);
+	e6809_map_read (&vecx_cpu, 0xe000, 0xffff, rom, NULL);
+
+	e6809_map_write (&vecx_cpu, 0x0000, 0xc7ff, NULL, NULL);
+	e6809_map_write (&vecx_cpu, 0xc800, 0xcbff, ram, NULL);
+	e6809_map_write (&vecx_cpu, 0xcc00, 0xcfff, ram, NULL);
+	e6809_map_write (&vecx_cpu, 0xd000, 0xd7ff, NULL, io_write8);
+	e6809_map_write (&vecx_cpu, 0xd800, 0xdfff, NULL, ramio_write8);
+	e6809_map_write (&vecx_cpu, 0xe000, 0xffff, NULL, NULL);
+
+	/* code can run from the bios, the cartridge and the ram. the ram is
+	 * mirrored, writes to a mirror have to invalidate cached code too.
+	 */
+
+	e6809_dcache_map (&vecx_cpu, 0x0000, 0x7fff, E6809_MAP_ROM, 0x0000);
+	e6809_dcache_map (&vecx_cpu, 0xe000, 0xffff, E6809_MAP_ROM, 0xe000);
+	e6809_dcache_map (&vecx_cpu, 0xc800, 0xcbff, E6809_MAP_RAM, 0xc800);
+	e6809_dcache_map (&vecx_cpu, 0xcc00, 0xcfff, E6809_MAP_ALIAS, 0xc800);
+	e6809_dcache_map (&vecx_cpu, 0xd800, 0xdbff, E6809_MAP_ALIAS, 0xc800);
+	e6809_dcache_map (&vecx_cpu, 0xdc00, 0xdfff, E6809_MAP_ALIAS, 0xc800);
 
-	e6809_read8 = read8;
-	e6809_write8 = write8;
+	/* the bios might have changed */
 
-	e6809_reset ();
+	hle_install ();
+
+	e6809_reset (&vecx_cpu);
 }
 
 /* perform a single cycle worth of via emulation.
@@ -610,69 +743,69 @@ static einline void via_sstep0 (void)
 {
 	unsigned t2shift;
 
-	if (via_t1on) {
-		via_t1c--;
+	if (vx.via_t1on) {
+		vx.via_t1c--;
 
-		if ((via_t1c & 0xffff) == 0xffff) {
+		if ((vx.via_t1c & 0xffff) == 0xffff) {
 			/* counter just rolled over */
 
-			if (via_acr & 0x40) {
+			if (vx.via_t1free) {
 				/* continuous interrupt mode */
 
-				via_ifr |= 0x40;
+				vx.via_ifr |= 0x40;
 				int_update ();
-				via_t1pb7 = 0x80 - via_t1pb7;
+				vx.via_t1pb7 = 0x80 - vx.via_t1pb7;
 
 				/* reload counter */
 
-				via_t1c = (via_t1lh << 8) | via_t1ll;
+				vx.via_t1c = (vx.via_t1lh << 8) | vx.via_t1ll;
 			} else {
 				/* one shot mode */
 
-				if (via_t1int) {
-					via_ifr |= 0x40;
+				if (vx.via_t1int) {
+					vx.via_ifr |= 0x40;
 					int_update ();
-					via_t1pb7 = 0x80;
-					via_t1int = 0;
+					vx.via_t1pb7 = 0x80;
+					vx.via_t1int = 0;
 				}
 			}
 		}
 	}
 
-	if (via_t2on && (via_acr & 0x20) == 0x00) {
-		via_t2c--;
+	if (vx.via_t2on && vx.via_t2count) {
+		vx.via_t2c--;
 
-		if ((via_t2c & 0xffff) == 0xffff) {
+		if ((vx.via_t2c & 0xffff) == 0xffff) {
 			/* one shot mode */
 
-			if (via_t2int) {
-				via_ifr |= 0x20;
+			if (vx.via_t2int) {
+				vx.via_ifr |= 0x20;
 				int_update ();
-				via_t2int = 0;
+				vx.via_t2int = 0;
 			}
 		}
 	}
 
 	/* shift counter */
 
-	via_src--;
+	vx.via_src--;
 
-	if ((via_src & 0xff) == 0xff) {
-		via_src = via_t2ll;
+	if ((vx.via_src & 0xff) == 0xff) {
+		vx.via_src = vx.via_t2ll;
 
-		if (via_srclk) {
+		if (vx.via_srclk) {
 			t2shift = 1;
-			via_srclk = 0;
+			vx.via_srclk = 0;
 		} else {
 			t2shift = 0;
-			via_srclk = 1;
+			vx.via_srclk = 1;
 		}
 	} else {
 		t2shift = 0;
 	}
 
-	if (via_srb < 8) {
-		switch (via_acr & 0x1c) {
+	if (vx.via_srb < 8) {
+		switch (vx.via_srmode) {
 		case 0x00:
 			/* disabled */
 			break;
@@ -682,16 +815,16 @@ static einline void via_sstep0 (void)
 			if (t2shift) {
 				/* shifting in 0s since cb2 is always an output */
 
-				via_sr <<= 1;
-				via_srb++;
+				vx.via_sr <<= 1;
+				vx.via_srb++;
 			}
 
 			break;
 		case 0x08:
 			/* shift in under system clk control */
 
-			via_sr <<= 1;
-			via_srb++;
+			vx.via_sr <<= 1;
+			vx.via_srb++;
 
 			break;
 		case 0x0c:
@@ -701,10 +834,10 @@ static einline void via_sstep0 (void)
 			/* shift out under t2 control (free run) */
 
 			if (t2shift) {
-				via_cb2s = (via_sr >> 7) & 1;
+				vx.via_cb2s = (vx.via_sr >> 7) & 1;
 
-				via_sr <<= 1;
-				via_sr |= via_cb2s;
+				vx.via_sr <<= 1;
+				vx.via_sr |= vx.via_cb2s;
 			}
 
 			break;
@@ -712,22 +845,22 @@ static einline void via_sstep0 (void)
 			/* shift out under t2 control */
 
 			if (t2shift) {
-				via_cb2s = (via_sr >> 7) & 1;
+				vx.via_cb2s = (vx.via_sr >> 7) & 1;
 
-				via_sr <<= 1;
-				via_sr |= via_cb2s;
-				via_srb++;
+				vx.via_sr <<= 1;
+				vx.via_sr |= vx.via_cb2s;
+				vx.via_srb++;
 			}
 
 			break;
 		case 0x18:
 			/* shift out under system clock control */
 
-			via_cb2s = (via_sr >> 7) & 1;
+			vx.via_cb2s = (vx.via_sr >> 7) & 1;
 
-			via_sr <<= 1;
-			via_sr |= via_cb2s;
-			via_srb++;
+			vx.via_sr <<= 1;
+			vx.via_sr |= vx.via_cb2s;
+			vx.via_srb++;
 
 			break;
 		case 0x1c:
@@ -735,8 +868,8 @@ static einline void via_sstep0 (void)
 			break;
 		}
 
-		if (via_srb == 8) {
-			via_ifr |= 0x04;
+		if (vx.via_srb == 8) {
+			vx.via_ifr |= 0x04;
 			int_update ();
 		}
 	}
@@ -746,34 +879,101 @@ static einline void via_sstep0 (void)
 
 static einline void via_sstep1 (void)
 {
-	if ((via_pcr & 0x0e) == 0x0a) {
+	if (vx.via_ca2pulse) {
 		/* if ca2 is in pulse mode, then make sure
 		 * it gets restored to '1' after the pulse.
 		 */
 
-		via_ca2 = 1;
+		vx.via_ca2 = 1;
 	}
 
-	if ((via_pcr & 0xe0) == 0xa0) {
+	if (vx.via_cb2pulse) {
 		/* if cb2 is in pulse mode, then make sure
 		 * it gets restored to '1' after the pulse.
 		 */
 
-		via_cb2h = 1;
+		vx.via_cb2h = 1;
 	}
 }
 
-//static einline void alg_addline (int x0, int y0, int x1, int y1, unsigned char color)
-static einline void alg_addline (vector_t v)
+/* where a line between the packed points p0 and p1, either way round,
+ * goes in vector_hash.
+ */
+
+static einline unsigned vector_key (unsigned p0, unsigned p1)
 {
-/*		vectors_draw[vector_draw_cnt].x0 = v.x0;
-		vectors_draw[vector_draw_cnt].y0 = v.y0;
-		vectors_draw[vector_draw_cnt].x1 = v.x1;
-		vectors_draw[vector_draw_cnt].y1 = v.y1;
-		vectors_draw[vector_draw_cnt].color = v.color;
-*/
-		memcpy(&vectors_draw[vector_draw_cnt], &v, sizeof(vector_t));
-		vector_draw_cnt++;
+	unsigned key;
+
+	if (p0 < p1) {
+		key = p0 * 0x9e3779b1 + p1;
+	} else {
+		key = p1 * 0x9e3779b1 + p0;
+	}
+
+	return (key ^ (key >> 16)) & (VECTOR_HASH - 1);
+}
+
+/* the index in the draw list of the line in slot key if it runs between
+ * p0 and p1, or -1.
+ */
+
+static einline int vector_find (unsigned key, unsigned p0, unsigned p1)
+{
+	vector_list_t *l = vectors_draw;
+	unsigned q0, q1;
+	int i;
+
+	i = vector_hash[key];
+
+	if (i < vector_draw_cnt) {
+		q0 = (unsigned) l->x0[i] << 16 | l->y0[i];
+		q1 = (unsigned) l->x1[i] << 16 | l->y1[i];
+
+		if ((q0 == p0 && q1 == p1) || (q0 == p1 && q1 == p0)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/* add a finished vector to the draw list, unless the list is full. many
+ * games draw the same line several times in a frame to make it brighter,
+ * so a line that is already in the list, either way round, only gets the
+ * intensity of the new one added to it.
+ */
+
+static einline void alg_addline (const vector_t *v)
+{
+	vector_list_t *l = vectors_draw;
+	int n = vector_draw_cnt;
+	unsigned p0, p1;
+	unsigned key, color;
+	int i;
+
+	p0 = (unsigned) v->x0 << 16 | v->y0;
+	p1 = (unsigned) v->x1 << 16 | v->y1;
+	key = vector_key (p0, p1);
+	i = vector_find (key, p0, p1);
+
+	if (i >= 0) {
+		color = l->color[i] + v->color;
+
+		if (color > VECTREX_COLORS - 1) {
+			color = VECTREX_COLORS - 1;
+		}
+
+		l->color[i] = color;
+	} else if (n < VECTOR_CNT) {
+		l->x0[n] = v->x0;
+		l->y0[n] = v->y0;
+		l->x1[n] = v->x1;
+		l->y1[n] = v->y1;
+		l->color[n] = v->color;
+		l->join[n] = n > 0 && ((unsigned) l->x1[n - 1] << 16 | l->y1[n - 1]) == p0;
+		vector_hash[key] = n;
+		vector_draw_cnt = n + 1;
+	}
 }
 
 /* perform a single cycle worth of analog emulation */
@@ -784,58 +984,57 @@ static einline void alg_sstep (void)
 	unsigned sig_ramp;
 	unsigned sig_blank;
 
-//	if ((via_acr & 0x10) == 0x10) {
-	if (via_acr & 0x10)  {
-		sig_blank = via_cb2s;
+	if (vx.via_blanksr) {
+		sig_blank = vx.via_cb2s;
 	} else {
-		sig_blank = via_cb2h;
+		sig_blank = vx.via_cb2h;
 	}
 
-	if (via_ca2 == 0) {
+	if (vx.via_ca2 == 0) {
 		/* need to force the current point to the 'orgin' so just
 		 * calculate distance to origin and use that as dx,dy.
 		 */
 
-		sig_dx = ALG_MAX_X / 2 - alg_curr_x;
-		sig_dy = ALG_MAX_Y / 2 - alg_curr_y;
+		sig_dx = ALG_MAX_X / 2 - vx.alg_curr_x;
+		sig_dy = ALG_MAX_Y / 2 - vx.alg_curr_y;
 	} else {
-		if (via_acr & 0x80) {
-			sig_ramp = via_t1pb7;
+		if (vx.via_pb7t1) {
+			sig_ramp = vx.via_t1pb7;
 		} else {
-			sig_ramp = via_orb & 0x80;
+			sig_ramp = vx.via_orb & 0x80;
 		}
 
 		if (sig_ramp == 0) {
-			sig_dx = alg_dx;
-			sig_dy = alg_dy;
+			sig_dx = vx.alg_dx;
+			sig_dy = vx.alg_dy;
 		} else {
 			sig_dx = 0;
 			sig_dy = 0;
 		}
 	}
 
-	if (alg_vectoring == 0) {
+	if (vx.alg_vectoring == 0) {
 		if (sig_blank == 1 &&
-			alg_curr_x >= 0 && alg_curr_x < ALG_MAX_X &&
-			alg_curr_y >= 0 && alg_curr_y < ALG_MAX_Y) {
+			vx.alg_curr_x >= 0 && vx.alg_curr_x < ALG_MAX_X &&
+			vx.alg_curr_y >= 0 && vx.alg_curr_y < ALG_MAX_Y) {
 
 			/* start a new vector */
 
-			alg_vectoring = 1;
-/*			alg_vector_x0 = alg_curr_x;
-			alg_vector_y0 = alg_curr_y;
-			alg_vector_x1 = alg_curr_x;
-			alg_vector_y1 = alg_curr_y;
-			alg_vector_color = (unsigned char) alg_zsh;
+			vx.alg_vectoring = 1;
+/*			alg_vector_x0 = vx.alg_curr_x;
+			alg_vector_y0 = vx.alg_curr_y;
+			alg_vector_x1 = vx.alg_curr_x;
+			alg_vector_y1 = vx.alg_curr_y;
+			alg_vector_color = (unsigned char) vx.alg_zsh;
 */
-			alg_vector.x0 = alg_curr_x;
-			alg_vector.y0 = alg_curr_y;
-			alg_vector.x1 = alg_curr_x;
-			alg_vector.y1 = alg_curr_y;
-			alg_vector.color = (unsigned char) alg_zsh;
-
-			alg_vector_dx = sig_dx;
-			alg_vector_dy = sig_dy;
+			vx.alg_vector.x0 = vx.alg_curr_x;
+			vx.alg_vector.y0 = vx.alg_curr_y;
+			vx.alg_vector.x1 = vx.alg_curr_x;
+			vx.alg_vector.y1 = vx.alg_curr_y;
+			vx.alg_vector.color = (unsigned char) vx.alg_zsh;
+
+			vx.alg_vector_dx = sig_dx;
+			vx.alg_vector_dy = sig_dy;
 		}
 	} else {
 		/* already drawing a vector ... check if we need to turn it off */
@@ -845,96 +1044,1200 @@ static einline void alg_sstep (void)
 			 * new line.
 			 */
 
-			alg_vectoring = 0;
+			vx.alg_vectoring = 0;
 
-			if ((framecount==0)||(framecount==Vex_cfg_Frameskip)) alg_addline (alg_vector);
-		} else if (sig_dx != alg_vector_dx ||
-				   sig_dy != alg_vector_dy ||
-				   (unsigned char) alg_zsh != alg_vector.color) {
+			if ((framecount==0)||(framecount==Vex_cfg_Frameskip)) alg_addline (&vx.alg_vector);
+		} else if (sig_dx != vx.alg_vector_dx ||
+				   sig_dy != vx.alg_vector_dy ||
+				   (unsigned char) vx.alg_zsh != vx.alg_vector.color) {
 
 			/* the parameters of the vectoring processing has changed.
 			 * so end the current line.
 			 */
 
-			if ((framecount==0)||(framecount==Vex_cfg_Frameskip)) alg_addline (alg_vector);
+			if ((framecount==0)||(framecount==Vex_cfg_Frameskip)) alg_addline (&vx.alg_vector);
 
 			/* we continue vectoring with a new set of parameters if the
 			 * current point is not out of limits.
 			 */
 
-			if (alg_curr_x >= 0 && alg_curr_x < ALG_MAX_X &&
-				alg_curr_y >= 0 && alg_curr_y < ALG_MAX_Y) {
-				alg_vector.x0 = alg_curr_x;
-				alg_vector.y0 = alg_curr_y;
-				alg_vector.x1 = alg_curr_x;
-				alg_vector.y1 = alg_curr_y;
-				alg_vector.color = (unsigned char) alg_zsh;
-				alg_vector_dx = sig_dx;
-				alg_vector_dy = sig_dy;
+			if (vx.alg_curr_x >= 0 && vx.alg_curr_x < ALG_MAX_X &&
+				vx.alg_curr_y >= 0 && vx.alg_curr_y < ALG_MAX_Y) {
+				vx.alg_vector.x0 = vx.alg_curr_x;
+				vx.alg_vector.y0 = vx.alg_curr_y;
+				vx.alg_vector.x1 = vx.alg_curr_x;
+				vx.alg_vector.y1 = vx.alg_curr_y;
+				vx.alg_vector.color = (unsigned char) vx.alg_zsh;
+				vx.alg_vector_dx = sig_dx;
+				vx.alg_vector_dy = sig_dy;
 			} else {
-				alg_vectoring = 0;
+				vx.alg_vectoring = 0;
 			}
 		}
 	}
 
-	alg_curr_x += sig_dx;
-	alg_curr_y += sig_dy;
+	vx.alg_curr_x += sig_dx;
+	vx.alg_curr_y += sig_dy;
 
-	if (alg_vectoring == 1 &&
-		alg_curr_x >= 0 && alg_curr_x < ALG_MAX_X &&
-		alg_curr_y >= 0 && alg_curr_y < ALG_MAX_Y) {
+	if (vx.alg_vectoring == 1 &&
+		vx.alg_curr_x >= 0 && vx.alg_curr_x < ALG_MAX_X &&
+		vx.alg_curr_y >= 0 && vx.alg_curr_y < ALG_MAX_Y) {
 
 		/* we're vectoring ... current point is still within limits so
 		 * extend the current vector.
 		 */
-		alg_vector.x1 = alg_curr_x;
-		alg_vector.y1 = alg_curr_y;
+		vx.alg_vector.x1 = vx.alg_curr_x;
+		vx.alg_vector.y1 = vx.alg_curr_y;
 	} 
 	
 }
 
-void vecx_emu (int cycles)
+/* is the beam position on the screen? */
+
+#define ALG_INSIDE(x, y) \
+	((x) >= 0 && (x) < ALG_MAX_X && (y) >= 0 && (y) < ALG_MAX_Y)
+
+/* the inputs of the integrators as alg_sstep sees them, returns blank */
+
+static einline unsigned alg_inputs (int *sig_dx, int *sig_dy)
+{
+	unsigned sig_ramp;
+
+	if (vx.via_ca2 == 0) {
+		*sig_dx = ALG_MAX_X / 2 - vx.alg_curr_x;
+		*sig_dy = ALG_MAX_Y / 2 - vx.alg_curr_y;
+	} else {
+		if (vx.via_pb7t1) {
+			sig_ramp = vx.via_t1pb7;
+		} else {
+			sig_ramp = vx.via_orb & 0x80;
+		}
+
+		if (sig_ramp == 0) {
+			*sig_dx = vx.alg_dx;
+			*sig_dy = vx.alg_dy;
+		} else {
+			*sig_dx = 0;
+			*sig_dy = 0;
+		}
+	}
+
+	if (vx.via_blanksr) {
+		return vx.via_cb2s;
+	} else {
+		return vx.via_cb2h;
+	}
+}
+
+/* narrow [*lo, *hi] down to the steps i for which p + i * s is in
+ * [0, max - 1].
+ */
+
+static void alg_range (int p, int s, int max, int *lo, int *hi)
+{
+	int a, b;
+
+	if (s == 0) {
+		if (p < 0 || p >= max) {
+			*hi = *lo - 1;
+		}
+
+		return;
+	}
+
+	if (s < 0) {
+		/* the same steps as going forward from the mirrored position */
+
+		p = max - 1 - p;
+		s = -s;
+	}
+
+	/* ceil (-p / s) and floor ((max - 1 - p) / s) */
+
+	a = p >= 0 ? 0 : (s - 1 - p) / s;
+	b = max - 1 - p;
+	b = b >= 0 ? b / s : -((s - 1 - b) / s);
+
+	if (a > *lo) {
+		*lo = a;
+	}
+
+	if (b < *hi) {
+		*hi = b;
+	}
+}
+
+/* advance the analog hardware by k cycles in which its inputs do not
+ * change. zeroing the beam, or a vector that ends or changes its
+ * parameters, takes a cycle of its own, after that the beam moves in a
+ * straight line. the line
+ * crosses the screen in one stretch of steps, so where a vector starts
+ * and how far it gets can be worked out instead of stepped.
+ */
+
+static void alg_run (int k)
 {
-	unsigned c, icycles;
+	int sig_dx, sig_dy, lo, hi, from;
+	unsigned sig_blank;
+
+	for (;;) {
+		if (k == 0) {
+			return;
+		}
 
-	while (cycles > 0) {
-		icycles = e6809_sstep (via_ifr & 0x80, 0);
+		sig_blank = alg_inputs (&sig_dx, &sig_dy);
 
-		for (c = 0; c < icycles; c++) {
-			via_sstep0 ();
-			alg_sstep ();
-			via_sstep1 ();
+		if ((vx.via_ca2 != 0 || (sig_dx == 0 && sig_dy == 0)) &&
+			(vx.alg_vectoring == 0 ||
+			 (sig_blank == 1 &&
+			  sig_dx == vx.alg_vector_dx && sig_dy == vx.alg_vector_dy &&
+			  (unsigned char) vx.alg_zsh == vx.alg_vector.color))) {
+			break;
 		}
 
-		cycles -= (int) icycles;
+		alg_sstep ();
+		k--;
+	}
 
-		fcycles -= (int) icycles;
+	/* the steps in which the beam is on the screen, i = 0 is now */
 
-		if (fcycles < 0) {
-			vector_t *tmp;
+	lo = 0;
+	hi = k;
+	alg_range (vx.alg_curr_x, sig_dx, ALG_MAX_X, &lo, &hi);
+	alg_range (vx.alg_curr_y, sig_dy, ALG_MAX_Y, &lo, &hi);
 
-			fcycles += FCYCLES_INIT;
-			
-			if (sound_getstate())
-				sound_callback(SOUND_SAMPLES_PER_FRAME);  
-			else
-				sound_start(SOUND_FREQUENCY,SOUND_SAMPLES_PER_FRAME);  
+	from = 1;
 
-			if (framecount == 0) 
-				osint_render ();
+	if (vx.alg_vectoring == 0 && sig_blank == 1 && lo < k && lo <= hi) {
+		/* start a new vector when the beam comes onto the screen */
 
-			/* everything that was drawn during this pass now now enters
-			 * the erase list for the next pass.
-			 */
+		vx.alg_vectoring = 1;
+		vx.alg_vector.x0 = vx.alg_curr_x + lo * sig_dx;
+		vx.alg_vector.y0 = vx.alg_curr_y + lo * sig_dy;
+		vx.alg_vector.x1 = vx.alg_vector.x0;
+		vx.alg_vector.y1 = vx.alg_vector.y0;
+		vx.alg_vector.color = (unsigned char) vx.alg_zsh;
+		vx.alg_vector_dx = sig_dx;
+		vx.alg_vector_dy = sig_dy;
+
+		from = lo + 1;
+	}
 
-			vector_erse_cnt = vector_draw_cnt;
-			vector_draw_cnt = 0;
+	if (vx.alg_vectoring == 1 && hi >= from && hi >= lo) {
+		/* the vector gets longer up to the last step on the screen */
 
-			tmp = vectors_erse;
-			vectors_erse = vectors_draw;
-			vectors_draw = tmp;
-			
-			osint_timer ();
+		vx.alg_vector.x1 = vx.alg_curr_x + hi * sig_dx;
+		vx.alg_vector.y1 = vx.alg_curr_y + hi * sig_dy;
+	}
+
+	vx.alg_curr_x += k * sig_dx;
+	vx.alg_curr_y += k * sig_dy;
+}
+
+/* the timer and shift counters over k cycles in which no timer runs out
+ * with an effect. a timer that has already run out in one shot mode just
+ * keeps counting down and wraps around.
+ */
+
+static void via_count (unsigned k)
+{
+	if (vx.via_t1on) {
+		vx.via_t1c -= k;
+	}
+
+	if (vx.via_t2on && vx.via_t2count) {
+		vx.via_t2c -= k;
+	}
+
+	if (k <= vx.via_src) {
+		vx.via_src -= k;
+	} else {
+		k -= vx.via_src + 1;
+		vx.via_srclk ^= (1 + k / (vx.via_t2ll + 1)) & 1;
+		vx.via_src = vx.via_t2ll - k % (vx.via_t2ll + 1);
+	}
+}
+
+/* the number of cycles, at most n, that go by before a timer runs out
+ * and sets its interrupt flag, reloads or toggles pb7.
+ */
+
+static int via_quiet (int n)
+{
+	if (vx.via_t1on && (vx.via_t1free || vx.via_t1int) && n > (int) (vx.via_t1c & 0xffff)) {
+		n = vx.via_t1c & 0xffff;
+	}
+
+	if (vx.via_t2on && vx.via_t2count && vx.via_t2int && n > (int) (vx.via_t2c & 0xffff)) {
+		n = vx.via_t2c & 0xffff;
+	}
+
+	return n;
+}
+
+/* the number of cycles, at most n, that go by before the cycle in which
+ * the shift register shifts its next bit. under control of timer 2 that
+ * is when the shift counter runs out for the second time, with srclk
+ * telling which time is next.
+ */
+
+static int via_sr_quiet (int n)
+{
+	int next;
+
+	if (vx.via_srb >= 8) {
+		return n;
+	}
+
+	switch (vx.via_srmode) {
+	case 0x04:
+	case 0x10:
+	case 0x14:
+		next = (int) (vx.via_src & 0xff);
+
+		if (vx.via_srclk == 0) {
+			next += (int) vx.via_t2ll + 1;
+		}
+
+		break;
+	case 0x08:
+	case 0x18:
+		next = 0;
+		break;
+	default:
+		/* disabled or under cb1 control, which is not connected */
+
+		next = n;
+		break;
+	}
+
+	return next < n ? next : n;
+}
+
+/* advance the via and the analog hardware by n cycles in which the via
+ * only counts. the first cycle is done in full, which also finishes any
+ * ca2 or cb2 pulse, then the inputs of the integrators stay the same and
+ * the rest is done in closed form.
+ */
+
+static void via_span (int n)
+{
+	via_sstep0 ();
+	alg_sstep ();
+	via_sstep1 ();
+
+	via_count (n - 1);
+	alg_run (n - 1);
+}
+
+/* advance the via and the analog hardware by the n cycles in which the
+ * shift register shifts out its last n bits under system clock control.
+ * the bits go to blank one per cycle, everything else stays the same
+ * after the first cycle, so each run of equal bits is one alg_run and
+ * the analog hardware only sees the edges of blank.
+ */
+
+static void via_shift (int n)
+{
+	int k, m;
+
+	via_sstep0 ();
+	alg_sstep ();
+	via_sstep1 ();
+
+	k = n - 1;
+
+	via_count (k);
+
+	while (k > 0) {
+		vx.via_cb2s = (vx.via_sr >> 7) & 1;
+
+		for (m = 0; m < k && ((vx.via_sr >> 7) & 1) == vx.via_cb2s; m++) {
+			vx.via_sr <<= 1;
+			vx.via_sr |= vx.via_cb2s;
+			vx.via_srb++;
 		}
+
+		alg_run (m);
+		k -= m;
+	}
+
+	if (vx.via_srb == 8) {
+		vx.via_ifr |= 0x04;
+		int_update ();
 	}
 }
+
+/* bring the via and the analog hardware up to the given cycle of the
+ * current e6809_run, from one event of the via or shift of the shift
+ * register to the next.
+ */
+
+static void via_catchup (int cycles)
+{
+	int n;
+
+	while (vx.via_done < cycles) {
+		n = via_quiet (cycles - vx.via_done);
+
+		if (vx.via_srb < 7 && vx.via_srmode == 0x18 && n >= 8 - (int) vx.via_srb) {
+			/* the rest of a pattern shifted out to blank */
+
+			n = 8 - (int) vx.via_srb;
+			via_shift (n);
+		} else {
+			n = via_sr_quiet (n);
+
+			if (n >= 2) {
+				via_span (n);
+			} else {
+				/* an event or a shift */
+
+				via_sstep0 ();
+				alg_sstep ();
+				via_sstep1 ();
+				n = 1;
+			}
+		}
+
+		vx.via_done += n;
+	}
+}
+
+/* the event scheduler. everything that has to happen at a given cycle is
+ * an event on one time line, vecx_now, the number of cycles since reset.
+ * the cpu runs from one event to the next in a single e6809_run. the via
+ * events only stop the cpu so that it sees the new interrupt lines, the
+ * others have a handler and come back every period cycles.
+ */
+
+/* schedule the events of the via: when it may set one of its interrupt
+ * flags. it is fine to be early, the cpu then just stops early.
+ */
+
+static void via_schedule (void)
+{
+	event_clear (EVENT_T1);
+	event_clear (EVENT_T2);
+	event_clear (EVENT_SR);
+
+	if (vx.via_t1on && (vx.via_t1free || vx.via_t1int)) {
+		event_set (EVENT_T1, (int) (vx.via_t1c & 0xffff) + 1);
+	}
+
+	if (vx.via_t2on && vx.via_t2count && vx.via_t2int) {
+		event_set (EVENT_T2, (int) (vx.via_t2c & 0xffff) + 1);
+	}
+
+	if (vx.via_srb < 8) {
+		switch (vx.via_srmode) {
+		case 0x08:
+		case 0x18:
+			/* one bit per cycle under system clock control */
+
+			event_set (EVENT_SR, 8 - (int) vx.via_srb);
+			break;
+		case 0x04:
+		case 0x14:
+			/* next time the shift counter reloads */
+
+			event_set (EVENT_SR, (int) (vx.via_src & 0xff) + 1);
+			break;
+		}
+	}
+}
+
+/* cycles until the next event, at most limit */
+
+static int event_next (int limit)
+{
+	unsigned event;
+	int n;
+
+	for (event = 0; event < EVENT_CNT; event++) {
+		if (event_on & (1 << event)) {
+			n = (int) (event_at[event] - vecx_now);
+
+			if (n < limit) {
+				limit = n;
+			}
+		}
+	}
+
+	return limit;
+}
+
+static void event_audio (void)
+{
+	if (sound_getstate())
+		sound_callback(SOUND_SAMPLES_PER_FRAME);  
+	else
+		sound_start(SOUND_FREQUENCY,SOUND_SAMPLES_PER_FRAME);  
+}
+
+/* the erase list holds what the last pass drew, which still glows on the
+ * screen. in a static scene most of it is drawn again in this pass, so
+ * before rendering take out every line that is also in the draw list and
+ * leave only the ones that are fading away.
+ */
+
+static void vector_diff (void)
+{
+	vector_list_t *l = vectors_erse;
+	unsigned p0, p1, end;
+	int v, n;
+
+	n = 0;
+	end = 0;
+
+	for (v = 0; v < vector_erse_cnt; v++) {
+		p0 = (unsigned) l->x0[v] << 16 | l->y0[v];
+		p1 = (unsigned) l->x1[v] << 16 | l->y1[v];
+
+		if (vector_find (vector_key (p0, p1), p0, p1) < 0) {
+			l->x0[n] = l->x0[v];
+			l->y0[n] = l->y0[v];
+			l->x1[n] = l->x1[v];
+			l->y1[n] = l->y1[v];
+			l->color[n] = l->color[v];
+			l->join[n] = n > 0 && end == p0;
+			end = p1;
+			n++;
+		}
+	}
+
+	vector_erse_cnt = n;
+}
+
+static void event_frame (void)
+{
+	vector_list_t *tmp;
+
+	if (framecount == 0) {
+		vector_diff ();
+		osint_render ();
+	}
+
+	/* everything that was drawn during this pass now now enters
+	 * the erase list for the next pass.
+	 */
+
+	vector_erse_cnt = vector_draw_cnt;
+	vector_draw_cnt = 0;
+
+	tmp = vectors_erse;
+	vectors_erse = vectors_draw;
+	vectors_draw = tmp;
+	
+	osint_timer ();
+}
+
+static void (*const event_fn[EVENT_CNT]) (void) = {
+	NULL, NULL, NULL, event_audio, event_frame, osint_input
+};
+
+static const int event_period[EVENT_CNT] = {
+	0, 0, 0, AUDIO_CYCLES, FCYCLES_INIT, INPUT_CYCLES
+};
+
+/* run the handlers of the events that are due, in the order of the list */
+
+static void event_dispatch (void)
+{
+	unsigned event;
+
+	for (event = EVENT_AUDIO; event < EVENT_CNT; event++) {
+		if ((event_on & (1 << event)) && (int) (event_at[event] - vecx_now) <= 0) {
+			event_at[event] += event_period[event];
+			event_fn[event] ();
+		}
+	}
+}
+
+void vecx_emu (int cycles)
+{
+	int budget, icycles;
+
+	emu_end += cycles;
+
+	while ((int) (emu_end - vecx_now) > 0) {
+		/* let the cpu run until the next event or until we are out of
+		 * cycles. sync and cwai skip ahead to the end of the run.
+		 */
+
+		via_schedule ();
+
+		budget = event_next ((int) (emu_end - vecx_now));
+
+		icycles = e6809_run (&vecx_cpu, budget, vx.via_ifr & 0x80, 0);
+
+		via_catchup (icycles);
+		vx.via_done = 0;
+
+		vecx_now += icycles;
+
+		event_dispatch ();
+	}
+}
+
+/* high level emulation of the bios routines that draw vector lists:
+ * Draw_VL, Draw_VLc, Draw_VLp, Mov_Draw_VL, Draw_Pat_VL and their other
+ * entry points, up to the return from Check0Ref, and of Print_Str, which
+ * Print_Str_d, Print_List and the others end up in. instead of running the
+ * 6809 code, hle_run and hle_print do what it does in c: the same
+ * accesses to the via at the same cycles, the same results in the
+ * registers and in ram. the waits for timer 1 are computed instead of
+ * polled, and the via and the beam are brought up to date with via_catchup,
+ * so each line of the list, or each character of a row of text, becomes
+ * its vectors in one step. the vectors are the same as with the cycle by
+ * cycle emulation.
+ *
+ * hle_trap goes through a routine twice. the dry run only counts the
+ * cycles, the routine is only done if it fits in the budget of the
+ * current e6809_run and cannot be interrupted.
+ */
+
+enum {
+	HLE_BIOS_SUM	= 0x09271471 /* of the routines in the known bios */
+};
+
+typedef struct {
+	e6809_t *cpu;
+	int dry;          /* only count the cycles */
+	int bad;          /* the list is in i/o space */
+	int t;            /* cycles since the routine was called */
+	unsigned t1ll;    /* timer 1 latch */
+	int t1start;      /* when timer 1 was started */
+	int t1c;          /* with which count */
+} hle_t;
+
+static unsigned hle_on;
+
+static const unsigned short hle_entries[] = {
+	0xf3ad, 0xf3b1, 0xf3b5, 0xf3b7, 0xf3b9, 0xf3bc, /* Mov_Draw_VL */
+	0xf3ce, 0xf3d2, 0xf3d6, 0xf3d8, 0xf3da, 0xf3dd, /* Draw_VL */
+	0xf404, 0xf408, 0xf40c, 0xf40e, 0xf410,         /* Draw_VLp */
+	0xf433, 0xf437,                                 /* Draw_Pat_VL */
+	0xf495, 0xf4a5                                  /* Print_Str */
+};
+
+static void hle_spend (hle_t *h, int cycles)
+{
+	h->t += cycles;
+
+	if (h->dry == 0) {
+		e6809_spend (h->cpu, cycles);
+	}
+}
+
+/* list data and ram */
+
+static unsigned hle_read (hle_t *h, unsigned address)
+{
+	address &= 0xffff;
+
+	if ((address & 0xf800) == 0xd000) {
+		h->bad = 1;
+		return 0;
+	}
+
+	return e6809_read8 (h->cpu, address);
+}
+
+static void hle_write (hle_t *h, unsigned address, unsigned data)
+{
+	if (h->dry == 0) {
+		e6809_write8 (h->cpu, address, data);
+	}
+}
+
+/* the via, register reg in the direct page */
+
+static unsigned hle_via_read (hle_t *h, unsigned reg)
+{
+	if (h->dry) {
+		return 0;
+	}
+
+	via_catchup (e6809_elapsed (h->cpu));
+
+	return e6809_read8 (h->cpu, 0xd000 | reg);
+}
+
+static void hle_via_write (hle_t *h, unsigned reg, unsigned data)
+{
+	if (reg == 0x4) {
+		h->t1ll = data;
+	} else if (reg == 0x5) {
+		h->t1start = h->t;
+		h->t1c = (data << 8) | h->t1ll;
+	}
+
+	if (h->dry == 0) {
+		via_catchup (e6809_elapsed (h->cpu));
+		e6809_write8 (h->cpu, 0xd000 | reg, data);
+	}
+}
+
+/* has timer 1 run out by now? */
+
+static int hle_t1done (hle_t *h)
+{
+	return h->t > h->t1start + h->t1c;
+}
+
+/* y to the y sample and hold, x to port a: ldd, sta <$01, clr <$00, gap
+ * cycles of other work, inc <$00, stb <$01
+ */
+
+static void hle_move (hle_t *h, unsigned y, unsigned x, int ldd, int gap)
+{
+	hle_spend (h, ldd);
+	hle_via_write (h, 0x1, y);
+	hle_spend (h, 4);
+	hle_via_write (h, 0x0, 0);
+	hle_spend (h, 6 + gap);
+	hle_via_write (h, 0x0, (hle_via_read (h, 0x0) + 1) & 0xff);
+	hle_spend (h, 6);
+	hle_via_write (h, 0x1, x);
+	hle_spend (h, 4);
+}
+
+/* sta <$0a with the blank pattern, timer 1 started with stb <$05 or clr
+ * <$05, ldd #$0040, bitb <$0d / beq until timer 1 runs out, nop, sta <$0a
+ * to blank again
+ */
+
+static void hle_ramp (hle_t *h, unsigned pattern, int start)
+{
+	int polls;
+
+	hle_via_write (h, 0xa, pattern);
+	hle_spend (h, 4);
+	hle_via_write (h, 0x5, 0);
+	hle_spend (h, start + 3);
+
+	polls = h->t1start + h->t1c + 1 - h->t;
+
+	if (polls > 0) {
+		hle_spend (h, (polls + 6) / 7 * 7);
+	}
+
+	hle_via_read (h, 0xd);
+	hle_spend (h, 7 + 2);
+	hle_via_write (h, 0xa, 0);
+	hle_spend (h, 4);
+}
+
+/* the routine at pc. the labels are the ones of the bios listing. */
+
+static void hle_run (hle_t *h, unsigned pc)
+{
+	unsigned a, b, x, s, n, nzvc;
+
+	a = e6809_get_reg (h->cpu, E6809_REG_A);
+	b = e6809_get_reg (h->cpu, E6809_REG_B);
+	x = e6809_get_reg (h->cpu, E6809_REG_X);
+	n = hle_read (h, 0xc823); /* Vec_Misc_Count */
+	h->t1ll = vx.via_t1ll;
+
+	switch (pc) {
+	case 0xf3ad: goto Mov_Draw_VLc_a;
+	case 0xf3b1: goto Mov_Draw_VL_b;
+	case 0xf3b5: goto Mov_Draw_VLcs;
+	case 0xf3b7: goto Mov_Draw_VL_ab;
+	case 0xf3b9: goto Mov_Draw_VL_a;
+	case 0xf3bc: goto Mov_Draw_VL;
+	case 0xf3ce: goto Draw_VLc;
+	case 0xf3d2: goto Draw_VL_b;
+	case 0xf3d6: goto Draw_VLcs;
+	case 0xf3d8: goto Draw_VL_ab;
+	case 0xf3da: goto Draw_VL_a;
+	case 0xf3dd: goto Draw_VL;
+	case 0xf404: goto Draw_VLp_FF;
+	case 0xf408: goto Draw_VLp_7F;
+	case 0xf40c: goto Draw_VLp_scale;
+	case 0xf40e: goto Draw_VLp_b;
+	case 0xf410: goto Draw_VLp;
+	case 0xf433: goto Draw_Pat_VL_a;
+	default: goto Draw_Pat_VL;
+	}
+
+Mov_Draw_VLc_a:
+	a = hle_read (h, x++);
+	hle_spend (h, 6 + 3);
+	goto Mov_Draw_VL_a;
+
+Mov_Draw_VL_b:
+	hle_via_write (h, 0x4, b);
+	hle_spend (h, 4 + 3);
+	goto Mov_Draw_VL;
+
+Mov_Draw_VLcs:
+	a = hle_read (h, x);
+	b = hle_read (h, x + 1);
+	x += 2;
+	hle_spend (h, 8);
+
+Mov_Draw_VL_ab:
+	hle_via_write (h, 0x4, b);
+	hle_spend (h, 4);
+
+Mov_Draw_VL_a:
+	n = a;
+	hle_write (h, 0xc823, n);
+	hle_spend (h, 5);
+
+Mov_Draw_VL:
+	/* a move: the same as a line, but blanked */
+
+	hle_move (h, hle_read (h, x), hle_read (h, x + 1), 5, 5 + 2);
+	x += 2;
+	hle_spend (h, 3 + 3);
+	hle_ramp (h, 0x00, 4);
+	goto Draw_VL_next;
+
+Draw_VLc:
+	a = hle_read (h, x++);
+	hle_spend (h, 6 + 3);
+	goto Draw_VL_a;
+
+Draw_VL_b:
+	hle_via_write (h, 0x4, b);
+	hle_spend (h, 4 + 3);
+	goto Draw_VL;
+
+Draw_VLcs:
+	a = hle_read (h, x);
+	b = hle_read (h, x + 1);
+	x += 2;
+	hle_spend (h, 8);
+
+Draw_VL_ab:
+	hle_via_write (h, 0x4, b);
+	hle_spend (h, 4);
+
+Draw_VL_a:
+	n = a;
+	hle_write (h, 0xc823, n);
+	hle_spend (h, 5);
+
+Draw_VL:
+	hle_move (h, hle_read (h, x), hle_read (h, x + 1), 5, 5 + 2);
+	x += 2;
+	hle_spend (h, 3);
+	hle_ramp (h, 0xff, 4);
+
+Draw_VL_next:
+	/* lda Vec_Misc_Count, deca, bpl Draw_VL_a */
+
+	a = (n - 1) & 0xff;
+	hle_spend (h, 5 + 2 + 3);
+
+	if ((a & 0x80) == 0) {
+		goto Draw_VL_a;
+	}
+
+	b = 0x40;
+	nzvc = 0x8;
+	hle_spend (h, 4);
+	goto Check0Ref;
+
+Draw_VLp_FF:
+	b = 0xff;
+	hle_spend (h, 2 + 3);
+	goto Draw_VLp_b;
+
+Draw_VLp_7F:
+	b = 0x7f;
+	hle_spend (h, 2 + 3);
+	goto Draw_VLp_b;
+
+Draw_VLp_scale:
+	b = hle_read (h, x++);
+	hle_spend (h, 6);
+
+Draw_VLp_b:
+	hle_via_write (h, 0x4, b);
+	hle_spend (h, 4);
+
+Draw_VLp:
+	/* pattern, y and x */
+
+	hle_move (h, hle_read (h, x + 1), hle_read (h, x + 2), 6, 4 + 5);
+	a = hle_read (h, x);
+	x += 3;
+	hle_ramp (h, a, 6);
+
+	/* lda ,x / ble Draw_VLp */
+
+	a = hle_read (h, x);
+	hle_spend (h, 4 + 3);
+
+	if (a == 0 || (a & 0x80)) {
+		goto Draw_VLp;
+	}
+
+	b = 0x40;
+	nzvc = 0x0;
+	hle_spend (h, 4);
+	goto Check0Ref;
+
+Draw_Pat_VL_a:
+	a = (a - 1) & 0xff;
+	n = a;
+	hle_write (h, 0xc823, n);
+	hle_spend (h, 2 + 5);
+
+Draw_Pat_VL:
+	/* the pattern is written to the shift register again every 18
+	 * cycles while the line is drawn
+	 */
+
+	hle_move (h, hle_read (h, x), hle_read (h, x + 1), 5, 5);
+	x += 2;
+	a = hle_read (h, 0xc829); /* Vec_Pattern */
+	b = 0x40;
+	hle_spend (h, 5 + 2);
+	hle_via_write (h, 0xa, a);
+	hle_spend (h, 4);
+	hle_via_write (h, 0x5, 0);
+	hle_spend (h, 6);
+
+	/* bitb $d00d / beq */
+
+	if (hle_t1done (h)) {
+		hle_via_read (h, 0xd);
+		hle_spend (h, 5 + 3);
+		hle_via_write (h, 0xa, 0);
+		a = n;
+		hle_spend (h, 6 + 5 + 3);
+
+		if (a != 0) {
+			goto Draw_Pat_VL_a;
+		}
+
+		/* rts */
+
+		nzvc = 0x4;
+		hle_spend (h, 5);
+		goto rts;
+	}
+
+	hle_via_read (h, 0xd);
+	hle_spend (h, 5 + 3);
+
+	for (;;) {
+		/* sta <$0a, nop, bitb <$0d, beq to lda Vec_Pattern */
+
+		hle_via_write (h, 0xa, a);
+		hle_spend (h, 4 + 2);
+
+		if (hle_t1done (h)) {
+			break;
+		}
+
+		hle_via_read (h, 0xd);
+		hle_spend (h, 4 + 3);
+		a = hle_read (h, 0xc829);
+		hle_spend (h, 5);
+	}
+
+	hle_via_read (h, 0xd);
+	hle_spend (h, 4 + 3);
+
+	/* lda Vec_Misc_Count, clr <$0a, tsta, bne Draw_Pat_VL_a */
+
+	a = n;
+	hle_spend (h, 5);
+	hle_via_write (h, 0xa, 0);
+	hle_spend (h, 6 + 2 + 3);
+
+	if (a != 0) {
+		goto Draw_Pat_VL_a;
+	}
+
+	nzvc = 0x4;
+	hle_spend (h, 4);
+
+Check0Ref:
+	/* zero the integrators if Vec_0Ref_Enable says so */
+
+	a = hle_read (h, 0xc824);
+	hle_spend (h, 5 + 3);
+
+	if (a == 0) {
+		nzvc = 0x4;
+	} else {
+		hle_spend (h, 3);
+		hle_via_write (h, 0xc, 0xcc);
+		hle_spend (h, 4);
+		hle_via_write (h, 0xa, 0x00);
+		hle_spend (h, 4 + 3);
+		hle_via_write (h, 0x1, 0);
+		hle_spend (h, 6);
+		hle_via_write (h, 0x0, 0x03);
+		hle_spend (h, 4);
+		hle_via_write (h, 0x0, 0x02);
+		hle_spend (h, 4);
+		hle_via_write (h, 0x0, 0x02);
+		hle_spend (h, 4 + 2);
+		hle_via_write (h, 0x0, 0x01);
+		hle_spend (h, 4);
+		a = 0x03;
+		b = 0x01;
+		nzvc = 0x0;
+	}
+
+	hle_spend (h, 5);
+
+rts:
+	if (h->dry) {
+		return;
+	}
+
+	s = e6809_get_reg (h->cpu, E6809_REG_S);
+
+	e6809_set_reg (h->cpu, E6809_REG_A, a);
+	e6809_set_reg (h->cpu, E6809_REG_B, b);
+	e6809_set_reg (h->cpu, E6809_REG_X, x);
+	e6809_set_reg (h->cpu, E6809_REG_CC,
+		(e6809_get_reg (h->cpu, E6809_REG_CC) & 0xf0) | nzvc);
+	e6809_set_reg (h->cpu, E6809_REG_PC,
+		(e6809_read8 (h->cpu, s) << 8) | e6809_read8 (h->cpu, s + 1));
+	e6809_set_reg (h->cpu, E6809_REG_S, s + 2);
+}
+
+/* Print_Str, from the start or from the top of the loop over the rows of
+ * the font. each character of a row is one byte of the font table
+ * shifted out to blank while the beam runs across, via_catchup turns it into
+ * its vectors in one go. ends with the jump to Reset0Ref.
+ */
+
+static void hle_print (hle_t *h, unsigned pc)
+{
+	unsigned a, b, x, u, start, cc, v;
+
+	b = e6809_get_reg (h->cpu, E6809_REG_B);
+	x = e6809_get_reg (h->cpu, E6809_REG_X);
+	u = e6809_get_reg (h->cpu, E6809_REG_U);
+	v = 0;
+
+	if (pc == 0xf4a5) {
+		/* x has to be one of the rows of the font */
+
+		if (x < 0xf9d4 || x > 0xfbb4 || (x - 0xf9d4) % 80 != 0) {
+			h->bad = 1;
+			return;
+		}
+
+		start = (hle_read (h, 0xc82c) << 8) | hle_read (h, 0xc82d);
+		goto Print_Str_row;
+	}
+
+	start = u;
+	hle_write (h, 0xc82c, u >> 8); /* Vec_Str_Ptr */
+	hle_write (h, 0xc82d, u & 0xff);
+	hle_spend (h, 6 + 3 + 3);
+	hle_via_write (h, 0x1, 0);
+	hle_spend (h, 6);
+	hle_via_write (h, 0xb, 0x18);
+	hle_spend (h, 4 + 3);
+	x = 0xf9d4;
+	b = 0x83;
+
+Print_Str_row:
+	/* zero x, move to the start of the row at the text width */
+
+	hle_via_write (h, 0x0, b);
+	hle_spend (h, 4);
+	hle_via_write (h, 0x0, (hle_via_read (h, 0x0) - 1) & 0xff);
+	hle_spend (h, 6 + 3 + 2);
+	hle_via_write (h, 0x0, (hle_via_read (h, 0x0) + 1) & 0xff);
+	hle_spend (h, 6);
+	hle_via_write (h, 0x0, 0x81);
+	hle_spend (h, 4);
+	hle_via_write (h, 0x0, 0x80);
+	hle_spend (h, 4 + 7);
+	hle_via_write (h, 0x0, (hle_via_read (h, 0x0) + 1) & 0xff);
+	hle_spend (h, 6);
+	a = hle_read (h, 0xc82b); /* Vec_Text_Width */
+	hle_spend (h, 5);
+	hle_via_write (h, 0x1, a);
+	hle_spend (h, 4 + 3);
+	u = start;
+	hle_spend (h, 6);
+	hle_via_write (h, 0x0, 0x01);
+	hle_spend (h, 4 + 3);
+
+	/* the characters */
+
+	for (;;) {
+		a = hle_read (h, u++);
+		hle_spend (h, 6 + 3);
+
+		if ((a & 0x80) || h->bad) {
+			break;
+		}
+
+		a = hle_read (h, x + a);
+		hle_spend (h, 5);
+		hle_via_write (h, 0xa, a);
+		hle_spend (h, 4);
+	}
+
+	/* back to the left at the text height */
+
+	hle_spend (h, 2);
+	hle_via_write (h, 0x0, 0x81);
+	hle_spend (h, 4);
+	v = hle_via_read (h, 0x1);
+	hle_via_write (h, 0x1, (0 - v) & 0xff);
+	hle_spend (h, 6 + 2);
+	hle_via_write (h, 0x0, 0x01);
+	hle_spend (h, 4 + 4 + 3);
+
+	if (x == 0xfbb4) {
+		goto Print_Str_done;
+	}
+
+	x += 80;
+	b = (((u - start) & 0xff) - 2) << 1 & 0xff;
+	hle_spend (h, 5 + 6 + 7 + 2 + 2 + 3 + (b ? b : 256) * 9);
+	hle_via_write (h, 0x0, 0x81);
+	hle_spend (h, 4);
+	b = hle_read (h, 0xc82a); /* Vec_Text_Height */
+	hle_spend (h, 5);
+	hle_via_write (h, 0x1, b);
+	hle_spend (h, 4);
+	hle_via_write (h, 0x0, (hle_via_read (h, 0x0) - 1) & 0xff);
+	hle_spend (h, 6 + 3 + 2);
+	hle_via_write (h, 0x0, 0x81);
+	hle_spend (h, 4);
+	hle_via_write (h, 0x1, 0);
+	hle_spend (h, 6);
+	hle_via_write (h, 0x0, 0x01);
+	hle_spend (h, 4);
+	hle_via_write (h, 0x0, 0x81);
+	hle_spend (h, 4 + 2 + 3);
+	b = 0x03;
+	goto Print_Str_row;
+
+Print_Str_done:
+	hle_spend (h, 2);
+	hle_via_write (h, 0xb, 0x98);
+	hle_spend (h, 4 + 4);
+
+	if (h->dry) {
+		return;
+	}
+
+	/* flags of lda #$98 after the cmpx, h from the neg */
+
+	cc = e6809_get_reg (h->cpu, E6809_REG_CC) & 0xd0;
+
+	if ((~v & ~(0 - v)) & 0x08) {
+		cc |= 0x20;
+	}
+
+	e6809_set_reg (h->cpu, E6809_REG_A, 0x98);
+	e6809_set_reg (h->cpu, E6809_REG_B, 0);
+	e6809_set_reg (h->cpu, E6809_REG_X, x);
+	e6809_set_reg (h->cpu, E6809_REG_U, u);
+	e6809_set_reg (h->cpu, E6809_REG_CC, cc | 0x08);
+	e6809_set_reg (h->cpu, E6809_REG_PC, 0xf354);
+}
+
+static int hle_trap (e6809_t *cpu)
+{
+	hle_t h;
+	unsigned pc, cc;
+	void (*run) (hle_t *h, unsigned pc);
+
+	pc = e6809_get_reg (cpu, E6809_REG_PC);
+	cc = e6809_get_reg (cpu, E6809_REG_CC);
+
+	/* the via has to be in the direct page, and interrupts masked */
+
+	if (e6809_get_reg (cpu, E6809_REG_DP) != 0xd0 ||
+		((cc & 0x10) == 0 && (vx.via_ier & 0x7f))) {
+		return 0;
+	}
+
+	if (pc == 0xf495 || pc == 0xf4a5) {
+		run = hle_print;
+	} else {
+		run = hle_run;
+	}
+
+	h.cpu = cpu;
+	h.dry = 1;
+	h.bad = 0;
+	h.t = 0;
+	h.t1start = 0;
+	h.t1c = 0;
+
+	run (&h, pc);
+
+	if (h.bad || h.t >= e6809_budget (cpu)) {
+		return 0;
+	}
+
+	h.dry = 0;
+	h.t = 0;
+
+	run (&h, pc);
+
+	return 1;
+}
+
+/* trap the routines if high level emulation is on and the bios is the
+ * one they are written for
+ */
+
+static void hle_install (void)
+{
+	unsigned i, sum;
+
+	sum = 0;
+
+	for (i = 0xf34f; i < 0xf511; i++) {
+		sum = sum * 31 + rom[i - 0xe000];
+	}
+
+	for (i = 0; i < sizeof (hle_entries) / sizeof (hle_entries[0]); i++) {
+		e6809_trap (&vecx_cpu, hle_entries[i],
+			hle_on && sum == HLE_BIOS_SUM ? hle_trap : NULL);
+	}
+}
+
+/* switch the cpu between superinstructions and the plain interpreter */
+
+void vecx_fuse (int on)
+{
+	e6809_fuse (&vecx_cpu, on);
+}
+
+/* switch the cpu between translated blocks and the interpreter */
+
+void vecx_translate (int on)
+{
+	e6809_translate (&vecx_cpu, on);
+}
+
+/* switch high level emulation of the bios drawing routines on or off */
+
+void vecx_hle (int on)
+{
+	hle_on = on;
+	hle_install ();
+}
+
+#ifdef E6809_PROFILE
+
+void vecx_profile_dump (const char *path)
+{
+	e6809_profile_dump (&vecx_cpu, path);
+}
+
+#endif
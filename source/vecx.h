@@ -10,16 +10,37 @@ enum {
 };
 
 typedef struct vector_type {
-	int x0, y0; /* start coordinate */
-	int x1, y1; /* end coordinate */
+	unsigned short x0, y0; /* start coordinate */
+	unsigned short x1, y1; /* end coordinate */
 
 	/* color [0, VECTREX_COLORS - 1], if color = VECTREX_COLORS, then this is
 	 * an invalid entry and must be ignored.
 	 */
-//	unsigned char color;
-	int color;
+	unsigned char color;
 } vector_t;
 
+enum {
+	/* max number of vectors in one list. a busy frame holds a few hundred,
+	 * whatever comes beyond this is dropped.
+	 */
+
+	VECTOR_CNT		= 4096
+};
+
+/* the vectors of one frame, one array per field, so the renderer only
+ * streams through what it reads. a line with join set starts where the
+ * one before it ends, a run of those makes up one connected strip.
+ */
+
+typedef struct vector_list {
+	unsigned short x0[VECTOR_CNT];
+	unsigned short y0[VECTOR_CNT];
+	unsigned short x1[VECTOR_CNT];
+	unsigned short y1[VECTOR_CNT];
+	unsigned char color[VECTOR_CNT];
+	unsigned char join[VECTOR_CNT];
+} vector_list_t;
+
 extern unsigned char rom[8192];
 extern unsigned char cart[32768];
 
@@ -31,10 +52,17 @@ extern unsigned alg_jch3;
 
 extern int vector_draw_cnt;
 extern int vector_erse_cnt;
-extern vector_t *vectors_draw;
-extern vector_t *vectors_erse;
+extern vector_list_t *vectors_draw;
+extern vector_list_t *vectors_erse;
 
 void vecx_reset (void);
 void vecx_emu (int cycles);
+void vecx_fuse (int on);
+void vecx_translate (int on);
+void vecx_hle (int on);
+
+#ifdef E6809_PROFILE
+void vecx_profile_dump (const char *path);
+#endif
 
 #endif
@@ -0,0 +1,456 @@
+/* e6809rec - static recompiler for vectrex roms
+ *
+ * usage: e6809rec [-e address]... bios.dat [cart.bin] out.c
+ *
+ * finds the code in the bios and the cartridge by recursive descent from
+ * the interrupt vectors, the start of the cartridge (after its header)
+ * and the addresses given with -e, and writes one c function per basic
+ * block to out.c. built with -DE6809_RECOMPILED=\"out.c\", e6809.c
+ * includes the file and e6809_run calls a block whenever the pc reaches
+ * its first instruction. everything else, e.g. code reached by jumps
+ * through registers or tables and code in ram, still runs on the
+ * interpreter. the blocks call the interpreter's handlers directly, so
+ * the result behaves exactly like the interpreter, minus decoding and
+ * dispatch. if the roms loaded at reset are not the ones the file was
+ * made from, it is not used.
+ *
+ * build on the host: cc -Isource -o e6809rec tools/e6809rec.c source/e6809tab.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "e6809.h"
+
+enum {
+	BIOS_START	= 0xe000,
+	BIOS_SIZE	= 8192,
+	CART_SIZE	= 32768,
+	MAX_ENTRIES	= 64
+};
+
+/* what is known about each address */
+
+enum {
+	ADDR_ROM	= 1, /* part of an image */
+	ADDR_INSN	= 2, /* an instruction starts here */
+	ADDR_LEADER	= 4  /* a basic block starts here */
+};
+
+/* how an instruction continues */
+
+enum {
+	FLOW_NEXT	= 1, /* with the next instruction */
+	FLOW_TARGET	= 2, /* at a target known at this point */
+	FLOW_END	= 4  /* ends a basic block */
+};
+
+static unsigned char mem[0x10000];
+static unsigned char attr[0x10000];
+static unsigned short stack[0x10000];
+static unsigned nstack;
+
+static unsigned char bios[BIOS_SIZE];
+static unsigned char cart[CART_SIZE];
+static unsigned cart_size;
+
+static unsigned load (const char *path, unsigned char *buf, unsigned size)
+{
+	FILE *f;
+	unsigned n;
+
+	f = fopen (path, "rb");
+
+	if (f == NULL) {
+		fprintf (stderr, "cannot open '%s'\n", path);
+		exit (1);
+	}
+
+	n = fread (buf, 1, size, f);
+	fclose (f);
+
+	return n;
+}
+
+/* length of the instruction at pc, 0 if it is undefined or does not fit
+ * in the images
+ */
+
+static unsigned insn_len (unsigned pc, const e6809_opinfo_t **info)
+{
+	const e6809_opinfo_t *op;
+	unsigned len, i;
+
+	op = &e6809_ops[0][mem[pc]];
+	len = op->len;
+
+	if (op->mode == E6809_AM_PAGE) {
+		op = &e6809_ops[mem[pc] - 0x0f][mem[(pc + 1) & 0xffff]];
+		len = op->len;
+	}
+
+	if (op->mode == E6809_AM_ILL) {
+		return 0;
+	}
+
+	if (op->mode == E6809_AM_IDX) {
+		i = (pc + (mem[pc] == 0x10 || mem[pc] == 0x11) + 1) & 0xffff;
+		len += e6809_postbytes[mem[i]].len;
+	}
+
+	for (i = 0; i < len; i++) {
+		if (pc + i > 0xffff || (attr[pc + i] & ADDR_ROM) == 0) {
+			return 0;
+		}
+	}
+
+	*info = op;
+
+	return len;
+}
+
+/* how the instruction at pc continues, target gets the known target */
+
+static unsigned insn_flow (unsigned pc, unsigned len, unsigned *target)
+{
+	unsigned op, post;
+
+	op = mem[pc];
+	post = mem[(pc + 1) & 0xffff];
+
+	if (op == 0x10) {
+		if (post >= 0x21 && post <= 0x2f) {
+			/* long conditional branches */
+
+			*target = (pc + len + ((mem[pc + 2] << 8) | mem[pc + 3])) & 0xffff;
+
+			return FLOW_NEXT | FLOW_TARGET | FLOW_END;
+		}
+
+		return post == 0x3f ? FLOW_END : FLOW_NEXT;
+	}
+
+	if (op == 0x11) {
+		return post == 0x3f ? FLOW_END : FLOW_NEXT;
+	}
+
+	switch (op) {
+	case 0x20: /* bra */
+		*target = (pc + len + (signed char) post) & 0xffff;
+		return FLOW_TARGET | FLOW_END;
+	case 0x16: /* lbra */
+		*target = (pc + len + ((post << 8) | mem[pc + 2])) & 0xffff;
+		return FLOW_TARGET | FLOW_END;
+	case 0x17: /* lbsr */
+		*target = (pc + len + ((post << 8) | mem[pc + 2])) & 0xffff;
+		return FLOW_NEXT | FLOW_TARGET | FLOW_END;
+	case 0x8d: /* bsr */
+		*target = (pc + len + (signed char) post) & 0xffff;
+		return FLOW_NEXT | FLOW_TARGET | FLOW_END;
+	case 0x7e: /* jmp extended */
+		*target = (post << 8) | mem[pc + 2];
+		return FLOW_TARGET | FLOW_END;
+	case 0xbd: /* jsr extended */
+		*target = (post << 8) | mem[pc + 2];
+		return FLOW_NEXT | FLOW_TARGET | FLOW_END;
+	case 0x9d: /* jsr direct and indexed */
+	case 0xad:
+	case 0x13: /* sync */
+	case 0x3c: /* cwai */
+		return FLOW_NEXT | FLOW_END;
+	case 0x0e: /* jmp direct and indexed */
+	case 0x6e:
+	case 0x39: /* rts */
+	case 0x3b: /* rti */
+	case 0x3f: /* swi */
+		return FLOW_END;
+	case 0x35: /* puls/pulu pc */
+	case 0x37:
+		return (post & 0x80) ? FLOW_END : FLOW_NEXT;
+	case 0x1e: /* exg/tfr with pc */
+		return ((post >> 4) == 5 || (post & 0xf) == 5) ? FLOW_END : FLOW_NEXT;
+	case 0x1f:
+		return (post & 0xf) == 5 ? FLOW_END : FLOW_NEXT;
+	}
+
+	if (op >= 0x21 && op <= 0x2f) {
+		*target = (pc + len + (signed char) post) & 0xffff;
+		return FLOW_NEXT | FLOW_TARGET | FLOW_END;
+	}
+
+	return FLOW_NEXT;
+}
+
+static void push (unsigned pc)
+{
+	if ((attr[pc] & ADDR_ROM) == 0) {
+		return;
+	}
+
+	attr[pc] |= ADDR_LEADER;
+	stack[nstack++ & 0xffff] = pc;
+}
+
+/* recursive descent: follow every path of execution that can be known
+ * without running the code
+ */
+
+static void trace (void)
+{
+	const e6809_opinfo_t *info;
+	unsigned pc, len, flow, target;
+
+	while (nstack) {
+		pc = stack[--nstack];
+
+		while ((attr[pc] & ADDR_INSN) == 0) {
+			len = insn_len (pc, &info);
+
+			if (len == 0) {
+				break;
+			}
+
+			attr[pc] |= ADDR_INSN;
+			flow = insn_flow (pc, len, &target);
+
+			if (flow & FLOW_TARGET) {
+				push (target);
+			}
+
+			if ((flow & FLOW_NEXT) == 0) {
+				break;
+			}
+
+			pc = (pc + len) & 0xffff;
+
+			if (flow & FLOW_END) {
+				push (pc);
+				break;
+			}
+		}
+	}
+}
+
+/* the first instruction of a cartridge follows its header: the copyright
+ * string up to 0x80, the music pointer and the title lines (height,
+ * width, y, x, text up to 0x80) up to a 0.
+ */
+
+static int cart_start (void)
+{
+	unsigned i;
+
+	if (cart_size < 16 || memcmp (cart, "g GCE", 5) != 0) {
+		return -1;
+	}
+
+	for (i = 0; i < cart_size && cart[i] != 0x80; i++) {
+	}
+
+	for (i += 3; i < cart_size && cart[i] != 0; ) {
+		for (i += 4; i < cart_size && cart[i] != 0x80; i++) {
+		}
+
+		i++;
+	}
+
+	return i + 1 < cart_size ? (int) i + 1 : -1;
+}
+
+static const char *image_of (unsigned pc)
+{
+	return pc >= BIOS_START ? "rec_bios" : "rec_cart";
+}
+
+static unsigned image_offset (unsigned pc)
+{
+	return pc >= BIOS_START ? pc - BIOS_START : pc;
+}
+
+static void write_image (FILE *f, const char *name, const unsigned char *buf, unsigned size)
+{
+	unsigned i;
+
+	fprintf (f, "static const unsigned char %s[%u] = {", name, size);
+
+	for (i = 0; i < size; i++) {
+		fprintf (f, "%s0x%02x,", (i & 15) ? " " : "\n\t", buf[i]);
+	}
+
+	fprintf (f, "\n};\n\n");
+}
+
+static void write_block (FILE *f, unsigned pc)
+{
+	const e6809_opinfo_t *info;
+	unsigned len, flow, target, oplen, page;
+	unsigned char bytes[E6809_DCACHE_MAXLEN];
+	char text[64], handler[32];
+	unsigned i;
+
+	fprintf (f, "static void rec_%04x (e6809_t *cpu)\n{\n\tunsigned int done;\n\n", pc);
+
+	for (;;) {
+		len = insn_len (pc, &info);
+		flow = insn_flow (pc, len, &target);
+
+		for (i = 0; i < E6809_DCACHE_MAXLEN; i++) {
+			bytes[i] = i < len ? mem[pc + i] : 0;
+		}
+
+		e6809_disasm (bytes, pc, text);
+
+		page = mem[pc] == 0x10 || mem[pc] == 0x11;
+		oplen = 1 + page;
+
+		if (page) {
+			sprintf (handler, "ins_0x%02x_0x%02x", mem[pc], mem[pc + 1]);
+		} else {
+			sprintf (handler, "ins_0x%02x", mem[pc]);
+		}
+
+		fprintf (f, "\tREC_INSN (%s + 0x%04x, 0x%04x, %u, %u, %s); /* %s */\n",
+			image_of (pc), image_offset (pc), pc, oplen, info->cycles, handler, text);
+
+		pc += len;
+
+		if ((flow & FLOW_END) || pc > 0xffff || (attr[pc] & (ADDR_LEADER | ADDR_INSN)) != ADDR_INSN) {
+			break;
+		}
+
+		fprintf (f, "\tREC_NEXT ();\n");
+	}
+
+	fprintf (f, "}\n\n");
+}
+
+int main (int argc, char **argv)
+{
+	unsigned entries[MAX_ENTRIES], nentries;
+	unsigned pc, page, blocks, used[256];
+	const char *files[3];
+	unsigned nfiles;
+	int start, i;
+	FILE *f;
+
+	nentries = 0;
+	nfiles = 0;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp (argv[i], "-e") == 0 && i + 1 < argc && nentries < MAX_ENTRIES) {
+			entries[nentries++] = strtoul (argv[++i], NULL, 16) & 0xffff;
+		} else if (nfiles < 3) {
+			files[nfiles++] = argv[i];
+		}
+	}
+
+	if (nfiles < 2) {
+		fprintf (stderr, "usage: e6809rec [-e address]... bios.dat [cart.bin] out.c\n");
+		return 1;
+	}
+
+	if (load (files[0], bios, BIOS_SIZE) != BIOS_SIZE) {
+		fprintf (stderr, "'%s' is not an 8k bios image\n", files[0]);
+		return 1;
+	}
+
+	memcpy (mem + BIOS_START, bios, BIOS_SIZE);
+	memset (attr + BIOS_START, ADDR_ROM, BIOS_SIZE);
+
+	if (nfiles == 3) {
+		cart_size = load (files[1], cart, CART_SIZE);
+		memcpy (mem, cart, cart_size);
+		memset (attr, ADDR_ROM, cart_size);
+	}
+
+	/* entry points: the vectors, the cartridge and the user's */
+
+	for (pc = 0xfff2; pc < 0x10000; pc += 2) {
+		push ((mem[pc] << 8) | mem[pc + 1]);
+	}
+
+	start = cart_start ();
+
+	if (start >= 0) {
+		push (start);
+	}
+
+	for (i = 0; i < (int) nentries; i++) {
+		push (entries[i]);
+	}
+
+	trace ();
+
+	f = fopen (files[nfiles - 1], "w");
+
+	if (f == NULL) {
+		fprintf (stderr, "cannot write '%s'\n", files[nfiles - 1]);
+		return 1;
+	}
+
+	fprintf (f, "/* generated by e6809rec from %s", files[0]);
+
+	if (nfiles == 3) {
+		fprintf (f, " and %s", files[1]);
+	}
+
+	fprintf (f, ", do not edit */\n\n");
+
+	write_image (f, "rec_bios", bios, BIOS_SIZE);
+
+	if (cart_size) {
+		write_image (f, "rec_cart", cart, cart_size);
+	}
+
+	/* the blocks, then a table of them for every page */
+
+	memset (used, 0, sizeof (used));
+	blocks = 0;
+
+	for (pc = 0; pc < 0x10000; pc++) {
+		if ((attr[pc] & (ADDR_LEADER | ADDR_INSN)) == (ADDR_LEADER | ADDR_INSN)) {
+			write_block (f, pc);
+			used[pc >> 8] = 1;
+			blocks++;
+		}
+	}
+
+	for (page = 0; page < 256; page++) {
+		if (used[page] == 0) {
+			continue;
+		}
+
+		fprintf (f, "static const rec_block_t rec_page_%02x[256] = {\n", page);
+
+		for (pc = page << 8; pc < (page + 1) << 8; pc++) {
+			if ((attr[pc] & (ADDR_LEADER | ADDR_INSN)) == (ADDR_LEADER | ADDR_INSN)) {
+				fprintf (f, "\t[0x%02x] = rec_%04x,\n", pc & 0xff, pc);
+			}
+		}
+
+		fprintf (f, "};\n\n");
+	}
+
+	fprintf (f, "static const rec_block_t *const rec_pages[256] = {\n");
+
+	for (page = 0; page < 256; page++) {
+		if (used[page]) {
+			fprintf (f, "\t[0x%02x] = rec_page_%02x,\n", page, page);
+		}
+	}
+
+	fprintf (f, "};\n\nstatic const rec_image_t rec_images[] = {\n");
+	fprintf (f, "\t{0x%04x, %u, rec_bios},\n", BIOS_START, BIOS_SIZE);
+
+	if (cart_size) {
+		fprintf (f, "\t{0x0000, %u, rec_cart},\n", cart_size);
+	}
+
+	fprintf (f, "\t{0, 0, NULL}\n};\n");
+	fclose (f);
+
+	printf ("%u basic blocks\n", blocks);
+
+	return 0;
+}